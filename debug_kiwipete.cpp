@@ -2,6 +2,7 @@
 #include "libs/chess_engine/include/chess_engine/FENString.h"
 #include <iostream>
 #include <chrono>
+#include <cstdint>
 
 int main() {
     // Kiwipete position
@@ -16,7 +17,7 @@ int main() {
         std::cout << "Running perft(5)..." << std::endl;
         auto start = std::chrono::high_resolution_clock::now();
         
-        unsigned long result = engine.perft(5);
+        std::uint64_t result = engine.perft(5);
         
         auto end = std::chrono::high_resolution_clock::now();
         auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(end - start);
@@ -0,0 +1,141 @@
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "../../src/Board.h"
+#include "../../src/XorShift64.h"
+#include "chess_engine/FENString.h"
+
+/*
+    FEN/EPD load throughput.
+
+        FenParseBench <file.epd>    parses every line of the file
+        FenParseBench               parses a generated set of SYNTHETIC_LINES positions
+
+    Each line is loaded with Board::setFromFen into one reused board. For comparison it is also
+    run through the FENString constructor alone, and through FENString plus a freshly built Board.
+    The file is read into memory first so only parsing is timed.
+*/
+
+static constexpr size_t SYNTHETIC_LINES{2'000'000};
+static constexpr size_t PLAYOUT_LENGTH{60};
+
+// Random playouts from the starting position, one FEN per ply. Fixed seed so every run sees the same set.
+static std::string generatePositions(size_t count) {
+    std::string text;
+    text.reserve(count * 64);
+
+    XorShift64 random{0x2545F4914F6CDD1DULL};
+
+    Board board;
+    char fen[Board::FEN_BUFFER_SIZE];
+    size_t ply = 0;
+    for(size_t i = 0; i < count; ++i) {
+        MoveList moves;
+        board.generateLegalMoves(moves);
+        if(moves.empty() || ply == PLAYOUT_LENGTH) {
+            board.setStartPosition();
+            ply = 0;
+            board.generateLegalMoves(moves);
+        }
+        board.makeMove(moves[random.next() % moves.size()]);
+        ++ply;
+
+        text.append(fen, board.writeFen(fen, sizeof(fen)));
+        text += '\n';
+    }
+    return text;
+}
+
+static std::vector<std::string_view> splitLines(const std::string& text) {
+    std::vector<std::string_view> lines;
+    size_t start = 0;
+    while(start < text.size()) {
+        size_t end = text.find('\n', start);
+        if(end == std::string::npos) {
+            end = text.size();
+        }
+        std::string_view line{text.data() + start, end - start};
+        if(!line.empty() && line.back() == '\r') {
+            line.remove_suffix(1);
+        }
+        if(!line.empty()) {
+            lines.push_back(line);
+        }
+        start = end + 1;
+    }
+    return lines;
+}
+
+static void report(const std::string& name, size_t lines, size_t failed, std::chrono::steady_clock::duration elapsed) {
+    double seconds = std::chrono::duration<double>(elapsed).count();
+    std::cout << name << ": " << lines << " lines in " << seconds << " s, "
+              << static_cast<std::uint64_t>(lines / seconds) << " lines/s";
+    if(failed > 0) {
+        std::cout << " (" << failed << " rejected)";
+    }
+    std::cout << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+    std::string text;
+    if(argc > 1) {
+        std::ifstream file{argv[1], std::ios::binary};
+        if(!file) {
+            std::cerr << "Cannot open " << argv[1] << std::endl;
+            return 1;
+        }
+        std::ostringstream contents;
+        contents << file.rdbuf();
+        text = contents.str();
+    } else {
+        std::cout << "Generating " << SYNTHETIC_LINES << " positions..." << std::endl;
+        text = generatePositions(SYNTHETIC_LINES);
+    }
+    std::vector<std::string_view> lines = splitLines(text);
+
+    Board board;
+    std::uint64_t checksum{0}; // Keeps the parse from being optimised away.
+    size_t failed = 0;
+    auto start = std::chrono::steady_clock::now();
+    for(std::string_view line : lines) {
+        if(board.setFromFen(line)) {
+            checksum ^= board.key();
+        } else {
+            ++failed;
+        }
+    }
+    report("Board::setFromFen", lines.size(), failed, std::chrono::steady_clock::now() - start);
+
+    failed = 0;
+    start = std::chrono::steady_clock::now();
+    for(std::string_view line : lines) {
+        try {
+            FENString fen{std::string{line}};
+            checksum ^= fen.getTotalMoves();
+        } catch(const std::exception&) {
+            ++failed;
+        }
+    }
+    report("FENString", lines.size(), failed, std::chrono::steady_clock::now() - start);
+
+    // What loading a position used to cost: validate into a FENString, then build a fresh Board from it.
+    failed = 0;
+    start = std::chrono::steady_clock::now();
+    for(std::string_view line : lines) {
+        try {
+            Board fresh{FENString{std::string{line}}};
+            checksum ^= fresh.key();
+        } catch(const std::exception&) {
+            ++failed;
+        }
+    }
+    report("Board{FENString}", lines.size(), failed, std::chrono::steady_clock::now() - start);
+
+    std::cout << "checksum " << checksum << std::endl;
+    return 0;
+}
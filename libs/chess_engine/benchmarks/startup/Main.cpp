@@ -0,0 +1,101 @@
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <numeric>
+#include <string>
+#include <vector>
+
+#ifndef _WIN32
+    #include <sys/wait.h>
+    #include <unistd.h>
+#endif
+
+/*
+    Time from process launch to "uciok".
+
+        StartupBench <engine binary> [runs]
+
+    Each run starts the engine in UCI mode, sends "uci" and stops the clock when "uciok" comes back,
+    then sends "quit" and waits for the process to exit. Reports min, median and mean over all runs.
+*/
+
+static constexpr int DEFAULT_RUNS{50};
+
+#ifndef _WIN32
+// Returns the launch to uciok time in microseconds, or a negative value on failure.
+static double timeToUciOk(const char* engine) {
+    int toEngine[2];
+    int fromEngine[2];
+    if(pipe(toEngine) != 0 || pipe(fromEngine) != 0) { return -1; }
+
+    auto start = std::chrono::steady_clock::now();
+    pid_t pid = fork();
+    if(pid < 0) { return -1; }
+    if(pid == 0) {
+        dup2(toEngine[0], STDIN_FILENO);
+        dup2(fromEngine[1], STDOUT_FILENO);
+        close(toEngine[0]);
+        close(toEngine[1]);
+        close(fromEngine[0]);
+        close(fromEngine[1]);
+        execl(engine, engine, "uci", static_cast<char*>(nullptr));
+        _exit(127);
+    }
+    close(toEngine[0]);
+    close(fromEngine[1]);
+
+    const std::string uci{"uci\n"};
+    bool ok = write(toEngine[1], uci.data(), uci.size()) == static_cast<ssize_t>(uci.size());
+
+    // Read until a whole "uciok" line has been seen.
+    std::string output;
+    char buffer[4096];
+    while(ok && output.find("uciok") == std::string::npos) {
+        ssize_t n = read(fromEngine[0], buffer, sizeof(buffer));
+        if(n <= 0) { ok = false; break; }
+        output.append(buffer, static_cast<size_t>(n));
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+
+    const std::string quit{"quit\n"};
+    ok = write(toEngine[1], quit.data(), quit.size()) == static_cast<ssize_t>(quit.size()) && ok;
+    close(toEngine[1]);
+    while(read(fromEngine[0], buffer, sizeof(buffer)) > 0) {}
+    close(fromEngine[0]);
+    waitpid(pid, nullptr, 0);
+
+    if(!ok) { return -1; }
+    return std::chrono::duration<double, std::micro>(elapsed).count();
+}
+#endif
+
+int main(int argc, char* argv[]) {
+#ifdef _WIN32
+    std::cerr << "StartupBench needs fork/exec and is not supported on Windows\n";
+    return 1;
+#else
+    if(argc < 2) {
+        std::cerr << "usage: StartupBench <engine binary> [runs]\n";
+        return 1;
+    }
+    int runs = argc > 2 ? std::stoi(argv[2]) : DEFAULT_RUNS;
+    if(runs <= 0) { runs = DEFAULT_RUNS; }
+
+    std::vector<double> times;
+    times.reserve(static_cast<size_t>(runs));
+    for(int i = 0; i < runs; ++i) {
+        double us = timeToUciOk(argv[1]);
+        if(us < 0) {
+            std::cerr << "engine did not answer uciok: " << argv[1] << "\n";
+            return 1;
+        }
+        times.push_back(us);
+    }
+
+    std::sort(times.begin(), times.end());
+    double mean = std::accumulate(times.begin(), times.end(), 0.0) / static_cast<double>(times.size());
+    std::cout << "launch to uciok over " << runs << " runs: min " << times.front() << " us, median "
+              << times[times.size() / 2] << " us, mean " << mean << " us\n";
+    return 0;
+#endif
+}
\ No newline at end of file
@@ -1,5 +1,6 @@
 #pragma once
 #include "FENString.h"
+#include <cstdint>
 #include <memory>
 #include <thread>
 #include <atomic>
@@ -8,10 +9,13 @@
 #include <fstream>
 #include <queue> // Command work queue
 #include "Types.h"
+#include "Move.h"
 
 class Board;
 class Square;
 class Piece;
+class WorkStealingPool;
+class PerftHash;
 
 class ChessEngine {
 
@@ -22,6 +26,10 @@ class ChessEngine {
 
     struct EngineOptionNames {
         std::string threads;
+        std::string perftSplitPly;
+        std::string perftHash;
+        std::string perftBulkCount;
+        std::string perftStats;
     };
 
     static const EngineID engineID;
@@ -29,16 +37,26 @@ class ChessEngine {
 
     public:
 
+        ChessEngine(); // Start position, nothing to parse.
         explicit ChessEngine(FENString fen);
         ~ChessEngine();
         std::string getFenStr() const;
+        MoveCheck_T checkMove(MoveCoordsData move) const noexcept; // Query only, the position is left untouched.
+        // Play the move if it is legal and report the game status that follows, INVALID otherwise.
         Game_Status isValidMove(MoveCoordsData move);
         Game_Status isValidMove(MoveCoordsData move, Piece_T promotionPiece);
+        Game_Status isValidMove(Move move);
         void uciStart();
 
-        unsigned long int perft(unsigned int depth);
+        std::uint64_t perft(unsigned int depth);
+        void setThreads(unsigned int threads); // 0 uses one thread per hardware thread, at most 1024.
+        void setPerftSplitPly(unsigned int ply); // Perft hands out one task per node down to this ply, 1 to 8.
+        void setPerftHashSize(size_t megabytes); // 0 turns the perft hash off, at most 16384.
+        // On by default, the last ply is counted from the move list. Off makes and unmakes every leaf move.
+        void setPerftBulkCounting(bool enabled);
+        // Counts captures, en passant, castles, promotions, checks and mates at the leaves, per root move.
+        void setPerftStatistics(bool enabled);
     private:
-        FENString m_fen;
         std::unique_ptr<Board> m_board;
         
         // Threading support for UCI
@@ -51,11 +69,27 @@ class ChessEngine {
         
         // UCI logging
         mutable std::ofstream m_uciLog;
+        mutable bool m_uciLogOpened{false};
+        bool _openLog() const;
         
+        // Perft runs on a pool that is kept between calls and rebuilt only when the thread count changes.
+        unsigned int m_threads{0}; // 0 is one per hardware thread, as the Threads option advertises.
+        unsigned int m_perftSplitPly{2};
+        std::unique_ptr<WorkStealingPool> m_perftPool;
+        bool m_perftBulkCounting{true};
+        bool m_perftStatistics{false};
+        size_t m_perftHashMegabytes{0};
+        std::unique_ptr<PerftHash> m_perftHash; // Allocated on the first perft after the size is set.
+        struct PerftRun;
+        struct PerftTask;
+
         UCICommand_T _commandHit(const std::string& in) const;
+        void _setOption(const std::string& name, const std::string& value);
 
-        unsigned long int _perft(unsigned int depth, bool showMoves);
-        unsigned long int _perftSingleThreaded(unsigned int depth);
+        std::uint64_t _perft(unsigned int depth, bool showMoves);
+        std::uint64_t _perftSingleThreaded(unsigned int depth);
+        WorkStealingPool& _perftPool();
+        PerftHash* _perftHash();
 
         std::string _collectSignal() const;
         void _executeSignal(std::string signal);
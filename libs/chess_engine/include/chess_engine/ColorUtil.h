@@ -4,4 +4,6 @@
 
 std::string colorToString(Color_T color);
 
-Color_T DPieceColor(DPiece_T p);
\ No newline at end of file
+Color_T DPieceColor(DPiece_T p);
+
+constexpr Color_T oppositeColor(Color_T color) { return color == Color_T::WHITE ? Color_T::BLACK : Color_T::WHITE; }
\ No newline at end of file
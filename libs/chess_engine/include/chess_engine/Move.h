@@ -0,0 +1,68 @@
+#pragma once
+#include "Types.h"
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+/*
+    A move packed into 16 bits:
+        bits  0-5   from square (row * 8 + col, a8 = 0, h1 = 63)
+        bits  6-11  to square
+        bits 12-13  promotion piece, KNIGHT..QUEEN stored as 0..3
+        bits 14-15  flag, see Flag_T
+
+    Castling is stored as the king's own move (e1g1), en passant as the capturing pawn's move.
+    The all-zero value is the null move, written "0000" in UCI.
+*/
+class Move final {
+    public:
+        enum class Flag_T : std::uint16_t { NORMAL, PROMOTION, EN_PASSANT, CASTLING };
+
+        constexpr Move() = default;
+        constexpr Move(size_t from, size_t to, Flag_T flag = Flag_T::NORMAL, Piece_T promotion = Piece_T::KNIGHT)
+            : m_data{static_cast<std::uint16_t>(from
+                    | (to << TO_SHIFT)
+                    | (flag == Flag_T::PROMOTION ? (static_cast<size_t>(promotion) - static_cast<size_t>(Piece_T::KNIGHT)) << PROMOTION_SHIFT : 0)
+                    | (static_cast<size_t>(flag) << FLAG_SHIFT))} {}
+
+        static constexpr Move none() { return Move{}; }
+
+        constexpr size_t from() const { return m_data & SQUARE_MASK; }
+        constexpr size_t to() const { return (m_data >> TO_SHIFT) & SQUARE_MASK; }
+        constexpr Flag_T flag() const { return static_cast<Flag_T>(m_data >> FLAG_SHIFT); }
+
+        // Piece_T::PAWN when the move is not a promotion.
+        constexpr Piece_T promotion() const {
+            return isPromotion()
+                ? static_cast<Piece_T>(((m_data >> PROMOTION_SHIFT) & 3) + static_cast<unsigned int>(Piece_T::KNIGHT))
+                : Piece_T::PAWN;
+        }
+
+        constexpr bool isPromotion() const { return flag() == Flag_T::PROMOTION; }
+        constexpr bool isEnPassant() const { return flag() == Flag_T::EN_PASSANT; }
+        constexpr bool isCastling() const { return flag() == Flag_T::CASTLING; }
+        constexpr bool isNone() const { return m_data == 0; }
+
+        constexpr MoveCoordsData toCoords() const { return {from() / MAX_COLS, from() % MAX_COLS, to() / MAX_COLS, to() % MAX_COLS}; }
+
+        constexpr std::uint16_t raw() const { return m_data; }
+        constexpr bool operator==(const Move& other) const = default;
+
+        // "e2e4", "e7e8q", "0000" for the null move.
+        std::string toUci() const;
+
+        // Squares and promotion only, the NORMAL/PROMOTION flag is all a string can tell us.
+        // Castling and en passant are recognised by matching against generated moves.
+        // Returns Move::none() for malformed input.
+        static Move fromUci(std::string_view uci);
+
+    private:
+        static constexpr unsigned int TO_SHIFT{6};
+        static constexpr unsigned int PROMOTION_SHIFT{12};
+        static constexpr unsigned int FLAG_SHIFT{14};
+        static constexpr std::uint16_t SQUARE_MASK{0x3F};
+
+        std::uint16_t m_data{0};
+};
+
+static_assert(sizeof(Move) == 2, "Move must stay packed into 16 bits.");
\ No newline at end of file
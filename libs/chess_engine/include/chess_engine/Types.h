@@ -1,5 +1,6 @@
 #pragma once
 #include <cstddef>
+#include <string_view>
 #include "chess_engine/FENString.h"
 
 static const size_t MAX_ROWS{8};
@@ -21,6 +22,9 @@ struct MoveCoordsData {
     size_t toRow, toCol;
 };
 
-static const FENString FEN_STARTING_POS{std::string{FENString::INIT_FEN}};
+inline constexpr std::string_view FEN_STARTING_POS{FENString::INIT_FEN}; // Board() and "position startpos" never parse it.
+
+// Result of a legality query, LEGAL or the first reason the move was rejected.
+enum class MoveCheck_T : unsigned int { LEGAL, NO_PIECE, WRONG_TURN, ILLEGAL_PATTERN, MUST_ESCAPE_CHECK, LEAVES_KING_IN_CHECK };
 
 enum class Game_Status : unsigned int { INVALID, CONTINUE, CHECKMATE_END, DRAW_END, IN_CHECK }; // Different statuses to be returned to Game for processing.
\ No newline at end of file
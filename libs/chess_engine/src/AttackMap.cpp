@@ -0,0 +1,73 @@
+#include "AttackMap.h"
+#include "Attacks.h"
+
+AttackMap::AttackMap() {
+    m_attacksFrom.fill(EMPTY_BB);
+    m_sideAttacks.fill(EMPTY_BB);
+}
+
+void AttackMap::rebuild(const Position& position) {
+    const Bitboard occupied = position.occupied();
+    m_attacksFrom.fill(EMPTY_BB);
+    for(Bitboard pieces = occupied; pieces; ) {
+        size_t sq = popLsb(pieces);
+        m_attacksFrom[sq] = _pieceAttacks(position.pieceOn(sq), sq, occupied);
+    }
+    _updateSideAttacks(position);
+}
+
+void AttackMap::update(const Position& position, Bitboard changed) {
+    const Bitboard occupied = position.occupied();
+
+    // Sliders elsewhere on the board whose rays ran into a changed square.
+    Bitboard sliders = (position.pieces(Piece_T::BISHOP) | position.pieces(Piece_T::ROOK) | position.pieces(Piece_T::QUEEN)) & ~changed;
+    while(sliders) {
+        size_t sq = popLsb(sliders);
+        if(m_attacksFrom[sq] & changed) {
+            m_attacksFrom[sq] = _pieceAttacks(position.pieceOn(sq), sq, occupied);
+        }
+    }
+
+    // Whatever stands on a changed square now, if anything.
+    while(changed) {
+        size_t sq = popLsb(changed);
+        m_attacksFrom[sq] = _pieceAttacks(position.pieceOn(sq), sq, occupied);
+    }
+
+    _updateSideAttacks(position);
+}
+
+Bitboard AttackMap::attacksFrom(size_t sq) const {
+    return m_attacksFrom[sq];
+}
+
+Bitboard AttackMap::attacks(Color_T color) const {
+    return m_sideAttacks[colorIndex(color)];
+}
+
+Bitboard AttackMap::_pieceAttacks(PieceCode piece, size_t sq, Bitboard occupied) {
+    if(piece == NO_PIECE) {
+        return EMPTY_BB;
+    }
+
+    switch(pieceCodeType(piece)) {
+        case Piece_T::PAWN:   return Attacks::pawn(pieceCodeColor(piece), sq);
+        case Piece_T::KNIGHT: return Attacks::knight(sq);
+        case Piece_T::BISHOP: return Attacks::bishop(sq, occupied);
+        case Piece_T::ROOK:   return Attacks::rook(sq, occupied);
+        case Piece_T::QUEEN:  return Attacks::queen(sq, occupied);
+        case Piece_T::KING:   return Attacks::king(sq);
+    }
+    return EMPTY_BB;
+}
+
+void AttackMap::_updateSideAttacks(const Position& position) {
+    for(Color_T color : {Color_T::WHITE, Color_T::BLACK}) {
+        Bitboard attacked{EMPTY_BB};
+        Bitboard pieces = position.pieces(color);
+        while(pieces) {
+            attacked |= m_attacksFrom[popLsb(pieces)];
+        }
+        m_sideAttacks[colorIndex(color)] = attacked;
+    }
+}
\ No newline at end of file
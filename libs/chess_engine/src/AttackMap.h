@@ -0,0 +1,30 @@
+#pragma once
+#include "Position.h"
+#include <array>
+
+/*
+    Squares attacked by every piece on the board, plus the union for each side.
+    Kept up to date move by move: only pieces standing on a changed square, and sliders whose
+    stored attack set reaches a changed square, are recomputed. A slider's ray can only change
+    when a square it currently sees (empty or its blocker) changes, so that test is exact, and
+    it works the same in both directions so unmaking a move uses the same update.
+*/
+class AttackMap final {
+    public:
+        AttackMap();
+
+        void rebuild(const Position& position);
+
+        // changed holds every square whose contents differ from the last update.
+        void update(const Position& position, Bitboard changed);
+
+        Bitboard attacksFrom(size_t sq) const;
+        Bitboard attacks(Color_T color) const; // Every square the color attacks.
+
+    private:
+        std::array<Bitboard, NUM_SQUARES> m_attacksFrom;
+        std::array<Bitboard, 2> m_sideAttacks;
+
+        static Bitboard _pieceAttacks(PieceCode piece, size_t sq, Bitboard occupied);
+        void _updateSideAttacks(const Position& position);
+};
\ No newline at end of file
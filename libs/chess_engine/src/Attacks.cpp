@@ -0,0 +1,167 @@
+#include "Attacks.h"
+#include "XorShift64.h"
+#include <mutex>
+#include <vector>
+
+// PEXT is only available on x86-64. Elsewhere the magic backend is the only one compiled in.
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+    #include <immintrin.h>
+    #define CHESS_PEXT_AVAILABLE 1
+    #define CHESS_TARGET_BMI2 __attribute__((target("bmi2")))
+#elif defined(_MSC_VER) && defined(_M_X64)
+    #include <immintrin.h>
+    #include <intrin.h>
+    #define CHESS_PEXT_AVAILABLE 1
+    #define CHESS_TARGET_BMI2
+#else
+    #define CHESS_PEXT_AVAILABLE 0
+    #define CHESS_TARGET_BMI2
+#endif
+
+Attacks::Backend_T Attacks::m_backend{Attacks::Backend_T::MAGIC};
+std::array<Attacks::Magic, NUM_SQUARES> Attacks::m_rookMagics{};
+std::array<Attacks::Magic, NUM_SQUARES> Attacks::m_bishopMagics{};
+std::array<Bitboard, Attacks::ROOK_TABLE_SIZE> Attacks::m_rookTable{};
+std::array<Bitboard, Attacks::BISHOP_TABLE_SIZE> Attacks::m_bishopTable{};
+
+namespace {
+#if CHESS_PEXT_AVAILABLE
+    CHESS_TARGET_BMI2 std::uint64_t pext(std::uint64_t value, std::uint64_t mask) {
+        return _pext_u64(value, mask);
+    }
+#endif
+
+    // Build the tables during static initialization so the first lookup never pays for it. Board
+    // calls init() too, for boards made before this initializer has run.
+    const bool s_tablesBuilt = (Attacks::init(), true);
+}
+
+void Attacks::init() {
+    static std::once_flag built;
+    std::call_once(built, [] {
+        m_backend = _cpuHasBmi2() ? Backend_T::PEXT : Backend_T::MAGIC;
+        _initMagics(m_rookMagics, m_rookTable.data(), m_rookDirections);
+        _initMagics(m_bishopMagics, m_bishopTable.data(), m_bishopDirections);
+    });
+}
+
+Attacks::Backend_T Attacks::backend() {
+    return m_backend;
+}
+
+std::string_view Attacks::backendName() {
+    return m_backend == Backend_T::PEXT ? "pext" : "magic";
+}
+
+bool Attacks::_cpuHasBmi2() {
+#if CHESS_PEXT_AVAILABLE && defined(_MSC_VER)
+    int info[4];
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 8)) != 0; // CPUID.(EAX=7, ECX=0):EBX bit 8.
+#elif CHESS_PEXT_AVAILABLE
+    return __builtin_cpu_supports("bmi2");
+#else
+    return false;
+#endif
+}
+
+// Only ever called once the CPU has reported BMI2.
+CHESS_TARGET_BMI2 Bitboard Attacks::_pextLookup(const Magic& m, Bitboard occupied) {
+#if CHESS_PEXT_AVAILABLE
+    return m.attacks[_pext_u64(occupied, m.mask)];
+#else
+    return m.attacks[m.index(occupied)];
+#endif
+}
+
+void Attacks::_initMagics(std::array<Magic, NUM_SQUARES>& magics, Bitboard* table, const std::array<Direction, 4>& directions) {
+    constexpr size_t MAX_SUBSETS{4096}; // A rook in the corner has 12 relevant blockers.
+    std::vector<Bitboard> occupancies(MAX_SUBSETS);
+    std::vector<Bitboard> references(MAX_SUBSETS);
+    std::vector<unsigned int> epoch(MAX_SUBSETS, 0);
+    XorShift64 random{0x9E3779B97F4A7C15ULL}; // Fixed seed so every run builds identical tables.
+    unsigned int attempt{0};
+    size_t offset{0};
+
+    for(size_t sq = 0; sq < NUM_SQUARES; ++sq) {
+        // Pieces on the board edge never block anything further along the ray.
+        Bitboard edges = ((rowBB(0) | rowBB(MAX_ROWS - 1)) & ~rowBB(squareRow(sq)))
+                       | ((colBB(0) | colBB(MAX_COLS - 1)) & ~colBB(squareCol(sq)));
+
+        Magic& m = magics[sq];
+        m.mask = _slide(sq, EMPTY_BB, directions) & ~edges;
+        m.shift = static_cast<unsigned int>(64 - popCount(m.mask));
+        m.attacks = table + offset;
+
+        // Enumerate every subset of the mask (Carry-Rippler) with its true attack set.
+        size_t size{0};
+        Bitboard subset{EMPTY_BB};
+        do {
+            occupancies[size] = subset;
+            references[size] = _slide(sq, subset, directions);
+            ++size;
+            subset = (subset - m.mask) & m.mask;
+        } while(subset);
+        offset += size;
+
+#if CHESS_PEXT_AVAILABLE
+        // pext packs the masked occupancy into a dense index, no magic search needed.
+        if(m_backend == Backend_T::PEXT) {
+            m.magic = 0;
+            for(size_t i = 0; i < size; ++i) {
+                m.attacks[pext(occupancies[i], m.mask)] = references[i];
+            }
+            continue;
+        }
+#endif
+
+        // Try random candidates until one maps every subset without a destructive collision.
+        size_t filled{0};
+        while(filled < size) {
+            do {
+                m.magic = random.sparse();
+            } while(popCount((m.magic * m.mask) >> 56) < 6);
+
+            ++attempt;
+            for(filled = 0; filled < size; ++filled) {
+                size_t idx = m.index(occupancies[filled]);
+                if(epoch[idx] < attempt) {
+                    epoch[idx] = attempt;
+                    m.attacks[idx] = references[filled];
+                } else if(m.attacks[idx] != references[filled]) {
+                    break;
+                }
+            }
+        }
+    }
+}
+
+// Ray walk used to fill the magic tables.
+Bitboard Attacks::_slide(size_t sq, Bitboard occupied, const std::array<Direction, 4>& directions) {
+    Bitboard attacks{EMPTY_BB};
+    for(const auto& [deltaRow, deltaCol] : directions) {
+        size_t current = sq;
+        while(Bitboard next = _step(current, deltaRow, deltaCol)) {
+            attacks |= next;
+            if(next & occupied) { break; } // Blocked, the blocker itself is still attacked.
+            current = lsb(next);
+        }
+    }
+    return attacks;
+}
+
+Bitboard Attacks::bishop(size_t sq, Bitboard occupied) {
+    const Magic& m = m_bishopMagics[sq];
+    if(m_backend == Backend_T::PEXT) { return _pextLookup(m, occupied); }
+    return m.attacks[m.index(occupied)];
+}
+
+Bitboard Attacks::rook(size_t sq, Bitboard occupied) {
+    const Magic& m = m_rookMagics[sq];
+    if(m_backend == Backend_T::PEXT) { return _pextLookup(m, occupied); }
+    return m.attacks[m.index(occupied)];
+}
+
+Bitboard Attacks::queen(size_t sq, Bitboard occupied) {
+    return bishop(sq, occupied) | rook(sq, occupied);
+}
\ No newline at end of file
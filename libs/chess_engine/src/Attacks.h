@@ -0,0 +1,137 @@
+#pragma once
+#include "Bitboard.h"
+#include <array>
+#include <string_view>
+#include <utility>
+
+/*
+    Attack set generation for every piece type.
+    Sliders stop at (and include) the first occupied square along each ray,
+    so the result contains capturable blockers of either color.
+
+    Pawn, knight and king attacks and the between/line geometry are plain lookups into tables
+    generated at compile time. They cost nothing at startup and are shared read-only by every thread.
+
+    Slider attacks come from magic bitboard tables: the relevant blockers are masked out of the
+    occupancy, multiplied by a per-square magic number and shifted down to index a table of
+    precomputed attack sets. The tables are built once at startup.
+
+    On x86-64 CPUs that report BMI2 the same tables are filled in PEXT order instead, and the
+    index is a single pext of the occupancy against the mask. The choice is made at runtime so
+    one binary runs everywhere, falling back to the magic multiply when BMI2 is missing.
+*/
+class Attacks final {
+    public:
+        enum class Backend_T : unsigned int { MAGIC, PEXT };
+
+        static Bitboard pawn(Color_T color, size_t sq) { return s_tables.pawn[colorIndex(color)][sq]; }
+        static Bitboard knight(size_t sq) { return s_tables.knight[sq]; }
+        static Bitboard king(size_t sq) { return s_tables.king[sq]; }
+        static Bitboard bishop(size_t sq, Bitboard occupied);
+        static Bitboard rook(size_t sq, Bitboard occupied);
+        static Bitboard queen(size_t sq, Bitboard occupied);
+
+        // Squares strictly between a and b when they share a rank, file or diagonal, otherwise empty.
+        static Bitboard between(size_t a, size_t b) { return s_tables.between[a][b]; }
+        // The whole rank, file or diagonal through a and b (both included), otherwise empty.
+        static Bitboard line(size_t a, size_t b) { return s_tables.line[a][b]; }
+
+        static void init(); // Picks the backend and builds the slider tables. Safe to call more than once.
+
+        static Backend_T backend();
+        static std::string_view backendName();
+
+    private:
+        using Direction = std::pair<int, int>; // { deltaRow, deltaCol }
+
+        struct Magic {
+            Bitboard mask;     // Squares whose occupancy can change the attack set (board edges excluded).
+            Bitboard magic;
+            Bitboard* attacks; // This square's slice of the shared attack table.
+            unsigned int shift;
+
+            size_t index(Bitboard occupied) const { return static_cast<size_t>(((occupied & mask) * magic) >> shift); }
+        };
+
+        struct Tables {
+            std::array<std::array<Bitboard, NUM_SQUARES>, 2> pawn{}; // Indexed by colorIndex.
+            std::array<Bitboard, NUM_SQUARES> knight{};
+            std::array<Bitboard, NUM_SQUARES> king{};
+            std::array<std::array<Bitboard, NUM_SQUARES>, NUM_SQUARES> between{};
+            std::array<std::array<Bitboard, NUM_SQUARES>, NUM_SQUARES> line{};
+        };
+
+        static constexpr size_t ROOK_TABLE_SIZE{0x19000};  // Sum over squares of 2^(relevant rook blockers).
+        static constexpr size_t BISHOP_TABLE_SIZE{0x1480}; // Same for bishops.
+
+        static constexpr std::array<Direction, 4> m_rookDirections{{ {-1, 0}, {1, 0}, {0, -1}, {0, 1} }};
+        static constexpr std::array<Direction, 4> m_bishopDirections{{ {-1, -1}, {-1, 1}, {1, -1}, {1, 1} }};
+        static constexpr std::array<Direction, 8> m_knightDeltas{{ {-2, -1}, {-2, 1}, {-1, -2}, {-1, 2}, {1, -2}, {1, 2}, {2, -1}, {2, 1} }};
+        static constexpr std::array<Direction, 8> m_kingDeltas{{ {-1, -1}, {-1, 0}, {-1, 1}, {0, -1}, {0, 1}, {1, -1}, {1, 0}, {1, 1} }};
+
+        static Backend_T m_backend;
+        static std::array<Magic, NUM_SQUARES> m_rookMagics;
+        static std::array<Magic, NUM_SQUARES> m_bishopMagics;
+        static std::array<Bitboard, ROOK_TABLE_SIZE> m_rookTable;
+        static std::array<Bitboard, BISHOP_TABLE_SIZE> m_bishopTable;
+        static const Tables s_tables;
+
+        static void _initMagics(std::array<Magic, NUM_SQUARES>& magics, Bitboard* table, const std::array<Direction, 4>& directions);
+        static bool _cpuHasBmi2();
+        static Bitboard _pextLookup(const Magic& m, Bitboard occupied);
+        static Bitboard _slide(size_t sq, Bitboard occupied, const std::array<Direction, 4>& directions);
+
+        // Single step from sq, or empty if it would leave the board.
+        static constexpr Bitboard _step(size_t sq, int deltaRow, int deltaCol) {
+            int row = static_cast<int>(squareRow(sq)) + deltaRow;
+            int col = static_cast<int>(squareCol(sq)) + deltaCol;
+
+            if(row < 0 || row >= static_cast<int>(MAX_ROWS) || col < 0 || col >= static_cast<int>(MAX_COLS)) {
+                return EMPTY_BB;
+            }
+            return squareBB(makeSquare(static_cast<size_t>(row), static_cast<size_t>(col)));
+        }
+
+        // Squares from sq along one direction up to the board edge, sq itself excluded.
+        static constexpr Bitboard _ray(size_t sq, const Direction& direction) {
+            Bitboard ray{EMPTY_BB};
+            for(Bitboard next = _step(sq, direction.first, direction.second); next;
+                next = _step(static_cast<size_t>(std::countr_zero(next)), direction.first, direction.second)) {
+                ray |= next;
+            }
+            return ray;
+        }
+
+        static constexpr Tables _generate() {
+            Tables tables{};
+            for(size_t sq = 0; sq < NUM_SQUARES; ++sq) {
+                // White pawns move up the board (decreasing row), black pawns down.
+                tables.pawn[colorIndex(Color_T::WHITE)][sq] = _step(sq, -1, -1) | _step(sq, -1, 1);
+                tables.pawn[colorIndex(Color_T::BLACK)][sq] = _step(sq, 1, -1) | _step(sq, 1, 1);
+                for(const auto& [deltaRow, deltaCol] : m_knightDeltas) {
+                    tables.knight[sq] |= _step(sq, deltaRow, deltaCol);
+                }
+                for(const auto& [deltaRow, deltaCol] : m_kingDeltas) {
+                    tables.king[sq] |= _step(sq, deltaRow, deltaCol);
+                }
+
+                // Walk each ray out from sq. Every square on it shares this line with sq, and the
+                // squares passed on the way are the ones between them.
+                for(const Direction& direction : m_kingDeltas) {
+                    const Direction opposite{-direction.first, -direction.second};
+                    const Bitboard fullLine = _ray(sq, direction) | _ray(sq, opposite) | squareBB(sq);
+                    Bitboard passed{EMPTY_BB};
+                    for(Bitboard next = _step(sq, direction.first, direction.second); next;
+                        next = _step(static_cast<size_t>(std::countr_zero(next)), direction.first, direction.second)) {
+                        const size_t target = static_cast<size_t>(std::countr_zero(next));
+                        tables.between[sq][target] = passed;
+                        tables.line[sq][target] = fullLine;
+                        passed |= next;
+                    }
+                }
+            }
+            return tables;
+        }
+};
+
+inline constexpr Attacks::Tables Attacks::s_tables{Attacks::_generate()};
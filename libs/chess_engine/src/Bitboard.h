@@ -0,0 +1,55 @@
+#pragma once
+#include "chess_engine/Types.h"
+#include <bit>
+#include <cstdint>
+
+/*
+    Bitboard primitives shared by the engine core.
+
+    A Bitboard is a set of squares, one bit per square. Squares are numbered the same way
+    the rest of the engine addresses the board: square = row * MAX_COLS + col, where row 0 is
+    rank 8 and col 0 is the A file. So a8 = 0, h8 = 7, a1 = 56 and h1 = 63.
+*/
+using Bitboard = std::uint64_t;
+
+static constexpr size_t NUM_SQUARES{MAX_ROWS * MAX_COLS};
+static constexpr size_t NO_SQUARE{NUM_SQUARES}; // Sentinel for "no square", e.g. no king on the board.
+
+// Compact piece encoding used by the mailbox: colorIndex * 6 + Piece_T.
+using PieceCode = std::uint8_t;
+static constexpr size_t NUM_PIECE_TYPES{6};
+static constexpr size_t NUM_PIECE_CODES{2 * NUM_PIECE_TYPES};
+static constexpr PieceCode NO_PIECE{NUM_PIECE_CODES};
+
+static constexpr Bitboard EMPTY_BB{0};
+static constexpr Bitboard FILE_A_BB{0x0101010101010101ULL};
+static constexpr Bitboard FILE_H_BB{FILE_A_BB << (MAX_COLS - 1)};
+
+constexpr size_t makeSquare(size_t row, size_t col) { return row * MAX_COLS + col; }
+constexpr size_t squareRow(size_t sq) { return sq / MAX_COLS; }
+constexpr size_t squareCol(size_t sq) { return sq % MAX_COLS; }
+
+constexpr Bitboard squareBB(size_t sq) { return Bitboard{1} << sq; }
+constexpr Bitboard rowBB(size_t row) { return Bitboard{0xFF} << (row * MAX_COLS); }
+constexpr Bitboard colBB(size_t col) { return FILE_A_BB << col; }
+
+// BLACK = 0, WHITE = 1. Used to index per-color arrays.
+constexpr size_t colorIndex(Color_T color) { return static_cast<size_t>(color); }
+
+constexpr PieceCode makePieceCode(Color_T color, Piece_T type) {
+    return static_cast<PieceCode>(colorIndex(color) * NUM_PIECE_TYPES + static_cast<size_t>(type));
+}
+constexpr Piece_T pieceCodeType(PieceCode code) { return static_cast<Piece_T>(code % NUM_PIECE_TYPES); }
+constexpr Color_T pieceCodeColor(PieceCode code) { return code >= NUM_PIECE_TYPES ? Color_T::WHITE : Color_T::BLACK; }
+
+inline size_t popCount(Bitboard b) { return static_cast<size_t>(std::popcount(b)); }
+
+// Index of the lowest set bit, NO_SQUARE when empty.
+inline size_t lsb(Bitboard b) { return static_cast<size_t>(std::countr_zero(b)); }
+
+// Removes and returns the lowest set square. b must not be empty.
+inline size_t popLsb(Bitboard& b) {
+    size_t sq = lsb(b);
+    b &= b - 1;
+    return sq;
+}
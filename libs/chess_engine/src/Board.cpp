@@ -1,4 +1,7 @@
 #include "Board.h"
+#include "Attacks.h"
+#include "Zobrist.h"
+#include "chess_engine/ColorUtil.h"
 #include <iostream>
 #include <string>
 #include <sstream>
@@ -7,6 +10,10 @@
 #include <limits>
 #include <algorithm>
 #include <cstdlib>
+#include <cassert>
+#include <charconv>
+#include <cstring>
+#include <string_view>
 
 #ifdef _WIN32
     #include <windows.h>
@@ -28,231 +35,211 @@ static void clearScreen() {
 #include "King.h"
 
 
-Board::Board() 
-    : Board({{ 
-            {'r', 'n', 'b', 'q', 'k', 'b', 'n', 'r'},
-            {'p', 'p', 'p', 'p', 'p', 'p', 'p', 'p'},
-            {' ', ' ', ' ', ' ', ' ', ' ', ' ', ' '},
-            {' ', ' ', ' ', ' ', ' ', ' ', ' ', ' '},
-            {' ', ' ', ' ', ' ', ' ', ' ', ' ', ' '},
-            {' ', ' ', ' ', ' ', ' ', ' ', ' ', ' '},
-            {'P', 'P', 'P', 'P', 'P', 'P', 'P', 'P'},
-            {'R', 'N', 'B', 'Q', 'K', 'B', 'N', 'R'}
-        }}) {}
-
-Board::Board(const FENString& fen) : m_lastPieceMoved{nullptr}, m_fen{fen.getFen()}{ 
-    std::string boardStr = fen.getBoardStr();
-    size_t row{0};
-    size_t col{0};
-    
-    // Initialize board to empty
-    std::array<std::array<char, MAX_COLS>, MAX_ROWS> boardToConstruct;
-    for(size_t i = 0; i < MAX_ROWS; ++i) {
-        for(size_t j = 0; j < MAX_COLS; ++j) {
-            boardToConstruct[i][j] = ' ';
-        }
+// Piece placement of the start position, built at compile time.
+static constexpr Position START_POSITION = [] {
+    constexpr Piece_T BACK_RANK[MAX_COLS]{Piece_T::ROOK, Piece_T::KNIGHT, Piece_T::BISHOP, Piece_T::QUEEN,
+                                          Piece_T::KING, Piece_T::BISHOP, Piece_T::KNIGHT, Piece_T::ROOK};
+    Position position;
+    for(size_t col = 0; col < MAX_COLS; ++col) {
+        position.putPiece(makeSquare(0, col), Color_T::BLACK, BACK_RANK[col]);
+        position.putPiece(makeSquare(1, col), Color_T::BLACK, Piece_T::PAWN);
+        position.putPiece(makeSquare(MAX_ROWS - 2, col), Color_T::WHITE, Piece_T::PAWN);
+        position.putPiece(makeSquare(MAX_ROWS - 1, col), Color_T::WHITE, BACK_RANK[col]);
     }
-    
-    for(char p : boardStr){
-        if(p != fen.getPosDelim()){
-            if(!std::isdigit(p)){
-                if(col < MAX_COLS) {
-                    boardToConstruct[row][col] = p; 
-                    ++col;
-                }
-            } else {
-                size_t spaces = p - '0';
-                for(size_t i = 0; i < spaces && col < MAX_COLS; ++i) {
-                    ++col;
-                }
-            }
-        } else {
-            ++row;
-            col = 0;
-        }
-    }
-    
-    // -------------------1----------------------- 2 --3- 4 5 6
-    // rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1
-    std::string fenCastleRightsStr = fen.getCastlingRightsStr();
-    _initCastleRights(fenCastleRightsStr);
-
-    std::string fenEnPassantStr = fen.getEnPassantTarget();
-    _initEnPassantCheck(fenEnPassantStr);
-    m_whiteKingInCheck = false;
-    m_blackKingInCheck = false;
-    
-    m_totalHalfMoves = fen.getHalfMoveClock();
+    return position;
+}();
 
-    m_totalMoves = fen.getTotalMoves();
+Board::Board() {
+    _initSquares();
+    setStartPosition();
+}
+
+Board::Board(const FENString& fen) {
+    _initSquares();
+    if(!setFromFen(fen.getFen())) {
+        throw std::invalid_argument("Error: Invalid FEN!");
+    }
+}
 
+Board::Board(const Snapshot& snapshot) {
+    Attacks::init();
+    _initSquares();
+    setFromSnapshot(snapshot);
+}
 
-    board = std::array<std::array<Square, MAX_COLS>, MAX_ROWS>();
+Board::Board(const std::array<std::array<char, MAX_COLS>, MAX_ROWS>& initBoardMapping) {
+    m_state.castling = BoardState::ALL_CASTLING;
+    _initSquares();
 
-    // Initialize pieces array to nullptr
     for(size_t row = 0; row < MAX_ROWS; ++row) {
         for(size_t col = 0; col < MAX_COLS; ++col) {
-            pieces[row][col] = nullptr;
+            char pieceChar = initBoardMapping[row][col];
+            if(pieceChar != ' ') {
+                Color_T pieceColor = std::isupper(pieceChar) ? Color_T::WHITE : Color_T::BLACK;
+                m_position.putPiece(makeSquare(row, col), pieceColor, _charToPieceType(pieceChar));
+            }
         }
     }
 
-    // Single loop for both squares and pieces
+    _resetDerivedState();
+}
+
+void Board::_initSquares() {
     for(size_t row = 0; row < MAX_ROWS; ++row) {
         for(size_t col = 0; col < MAX_COLS; ++col) {
-            // Create board.
             Color_T squareColor = ((row + col) % 2 == 0) ? Color_T::WHITE : Color_T::BLACK;
             board[row][col] = Square{squareColor, static_cast<unsigned int>(row), static_cast<unsigned int>(col)};
-            
-            // Populate Pieces.
-            char pieceChar = boardToConstruct[row][col];
-            if(pieceChar != ' ') {
-                Color_T pieceColor = std::isupper(pieceChar) ? Color_T::WHITE : Color_T::BLACK;
-                pieces[row][col] = _createPiece(pieceChar, pieceColor, board[row][col]);
-                getBoardAt(row, col).setOccupied(true);
-            }
         }
     }
+}
 
-    if(m_fen.getEnPassantTarget() != "-"){
-        unsigned int row{0};
-        unsigned int col{0};
-
-        notationToCoords(m_fen.getEnPassantTarget(), row, col);
-
-        if(row <= MAX_ROWS / 2){ // White pawn
-            Piece* p = pieces[row + 1][col].get();
-            if(p){
-                if(p->getType() == Piece_T::PAWN){
-                    Pawn* pawn = dynamic_cast<Pawn*>(p);
-                    pawn->setHasMoved(true);
-                    pawn->setEnPassantCaptureStatus(true);
-                }
-            } else {
-                throw std::invalid_argument("Error: Bad Conversion");
-            }
+// Piece codes by FEN letter, NO_PIECE for anything that is not one.
+static constexpr std::array<PieceCode, 128> FEN_PIECE_CODES = [] {
+    std::array<PieceCode, 128> codes{};
+    codes.fill(NO_PIECE);
+    constexpr char letters[]{'p', 'n', 'b', 'r', 'q', 'k'};
+    for(size_t type = 0; type < NUM_PIECE_TYPES; ++type) {
+        codes[static_cast<size_t>(letters[type])] = makePieceCode(Color_T::BLACK, static_cast<Piece_T>(type));
+        codes[static_cast<size_t>(letters[type] - 'a' + 'A')] = makePieceCode(Color_T::WHITE, static_cast<Piece_T>(type));
+    }
+    return codes;
+}();
+
+// Single pass over the text with no allocation. Fields go into locals first and are only copied
+// over once the whole string checks out, so a rejected FEN leaves the board as it was.
+// The two clocks are optional and anything after them is ignored, which lets EPD lines through.
+bool Board::setFromFen(std::string_view fen) {
+    size_t pos = 0;
+    auto skipSpaces = [&] {
+        size_t start = pos;
+        while(pos < fen.size() && fen[pos] == ' ') { ++pos; }
+        return pos > start;
+    };
+
+    // 1. Piece placement, rank 8 first.
+    Position position;
+    size_t row = 0;
+    size_t col = 0;
+    for(; pos < fen.size() && fen[pos] != ' '; ++pos) {
+        char c = fen[pos];
+        if(c == '/') {
+            if(col != MAX_COLS || ++row == MAX_ROWS) { return false; }
+            col = 0;
+        } else if(c >= '1' && c <= '8') {
+            col += static_cast<size_t>(c - '0');
+            if(col > MAX_COLS) { return false; }
         } else {
-            Piece* p = pieces[row - 1][col].get();
-            if(p){
-                if(p->getType() == Piece_T::PAWN){
-                    Pawn* pawn = dynamic_cast<Pawn*>(p);
-                    pawn->setHasMoved(true);
-                    pawn->setEnPassantCaptureStatus(true);
-                }
-            } else {
-                throw std::invalid_argument("Error: Bad Conversion");
-            }
+            PieceCode code = static_cast<unsigned char>(c) < FEN_PIECE_CODES.size() ? FEN_PIECE_CODES[static_cast<unsigned char>(c)] : NO_PIECE;
+            if(code == NO_PIECE || col == MAX_COLS) { return false; }
+            position.putPiece(makeSquare(row, col++), pieceCodeColor(code), pieceCodeType(code));
         }
     }
+    if(row != MAX_ROWS - 1 || col != MAX_COLS) { return false; }
 
-    // Populate each pieces attacking std::vector<const Square*>.
-    for(size_t row = 0; row < MAX_ROWS; ++row) {
-        for(size_t col = 0; col < MAX_COLS; ++col) {
-            Piece* p = pieces[row][col].get();
-            if(!p){continue;}
-            for(size_t rowJ = 0; rowJ < MAX_ROWS; ++rowJ) {
-                for(size_t colJ = 0; colJ < MAX_COLS; ++colJ) {
-                    const Square& to = getBoardAt(rowJ, colJ);
-                    if(to.isOccupied()){
-                        const Piece* attackedPiece = pieces[rowJ][colJ].get();
-                        if(p->isValidMove(to)){
-                            if(attackedPiece->getType() == Piece_T::KING){
-                                switch(attackedPiece->getColor()){
-                                    case Color_T::BLACK:
-                                        m_blackKingInCheck = true;
-                                        break;
-                                    case Color_T::WHITE:
-                                        m_whiteKingInCheck = true;
-                                        break;
-                                }
-                            }
-                            p->addToAttacking(attackedPiece); // Add this piece to the vector of attacked pieces for this piece.
-                        }
-                    }
-                }
+    // Move generation relies on both: a pawn on the first or last rank would step off the board, and
+    // legality is judged from the one king of each side.
+    if(position.pieces(Piece_T::PAWN) & (rowBB(0) | rowBB(MAX_ROWS - 1))) { return false; }
+    if(popCount(position.pieces(Color_T::WHITE, Piece_T::KING)) != 1 || popCount(position.pieces(Color_T::BLACK, Piece_T::KING)) != 1) {
+        return false;
+    }
+
+    // 2. Side to move.
+    if(!skipSpaces() || pos == fen.size() || (fen[pos] != 'w' && fen[pos] != 'b')) { return false; }
+    Color_T sideToMove = fen[pos++] == 'w' ? Color_T::WHITE : Color_T::BLACK;
+
+    // 3. Castling rights, "-" or any of KQkq.
+    if(!skipSpaces() || pos == fen.size()) { return false; }
+    std::uint8_t castling{0};
+    if(fen[pos] == '-') {
+        ++pos;
+    } else {
+        for(; pos < fen.size() && fen[pos] != ' '; ++pos) {
+            switch(fen[pos]) {
+                case 'K': castling |= BoardState::WHITE_SHORT; break;
+                case 'Q': castling |= BoardState::WHITE_LONG; break;
+                case 'k': castling |= BoardState::BLACK_SHORT; break;
+                case 'q': castling |= BoardState::BLACK_LONG; break;
+                default: return false;
             }
         }
     }
-}
 
-void Board::_initEnPassantCheck(std::string fenEnPassantStr) {
-    if(fenEnPassantStr != "-"){
-        m_checkToResetEnPassant = true;
+    // 4. En passant target. It has to sit right behind a pawn that just made its double push, so the
+    // target and the square the pawn left are both empty.
+    if(!skipSpaces() || pos == fen.size()) { return false; }
+    size_t epSquare = NO_SQUARE;
+    if(fen[pos] == '-') {
+        ++pos;
     } else {
-        m_checkToResetEnPassant = false;
-    }
+        if(pos + 1 >= fen.size() || fen[pos] < 'a' || fen[pos] > 'h') { return false; }
+        char rank = fen[pos + 1];
+        if(rank != (sideToMove == Color_T::WHITE ? '6' : '3')) { return false; }
+        epSquare = makeSquare(static_cast<size_t>('8' - rank), static_cast<size_t>(fen[pos] - 'a'));
+        size_t pawnSq = sideToMove == Color_T::WHITE ? epSquare + MAX_COLS : epSquare - MAX_COLS;
+        size_t originSq = sideToMove == Color_T::WHITE ? epSquare - MAX_COLS : epSquare + MAX_COLS;
+        if(position.pieceOn(pawnSq) != makePieceCode(oppositeColor(sideToMove), Piece_T::PAWN)) { return false; }
+        if(position.pieceOn(epSquare) != NO_PIECE || position.pieceOn(originSq) != NO_PIECE) { return false; }
+        pos += 2;
+    }
+    if(pos < fen.size() && fen[pos] != ' ') { return false; }
+
+    // 5 and 6. Halfmove clock and fullmove number, when present.
+    std::uint16_t halfMoves = 0;
+    std::uint16_t fullMoves = 1;
+    skipSpaces();
+    if(pos < fen.size() && std::isdigit(static_cast<unsigned char>(fen[pos]))) {
+        auto [end, error] = std::from_chars(fen.data() + pos, fen.data() + fen.size(), halfMoves);
+        if(error != std::errc{}) { return false; }
+        pos = static_cast<size_t>(end - fen.data());
+        skipSpaces();
+        if(pos < fen.size() && std::isdigit(static_cast<unsigned char>(fen[pos]))) {
+            auto [fullEnd, fullError] = std::from_chars(fen.data() + pos, fen.data() + fen.size(), fullMoves);
+            if(fullError != std::errc{} || fullMoves == 0) { return false; }
+            pos = static_cast<size_t>(fullEnd - fen.data());
+        }
+    }
+
+    m_position = position;
+    m_state = BoardState{};
+    m_state.sideToMove = sideToMove;
+    m_state.castling = castling;
+    m_state.epSquare = static_cast<std::uint8_t>(epSquare);
+    m_state.halfMoves = halfMoves;
+    m_state.fullMoves = fullMoves;
+    m_history.clear();
+    _resetDerivedState();
+    return true;
 }
 
-void Board::_initCastleRights(std::string fenCastleRights) {
-    m_castleRights = {false, false, false, false};
-    for(char castleChar : fenCastleRights){
-        if(castleChar == '-') {
-            // White long, white short, black long, black short
-            break;
-        } else if (castleChar == 'K'){
-            m_castleRights.whiteShort = true;
-        } else if (castleChar == 'Q'){
-            m_castleRights.whiteLong = true;
-        } else if (castleChar == 'k'){
-            m_castleRights.blackShort = true;
-        } else if (castleChar == 'q'){
-            m_castleRights.blackLong = true;
-        } else if (castleChar == '\0'){
-            continue;
-        } else {
-            throw std::invalid_argument("Error: Invalid FEN Castle structure.");
-        }
-    }
+// Copies the compile time start position, only the attack map and key are worked out here.
+void Board::setStartPosition() {
+    m_position = START_POSITION;
+    m_state = BoardState{};
+    m_state.castling = BoardState::ALL_CASTLING;
+    m_history.clear();
+    _resetDerivedState();
 }
 
-Board::Board(const std::array<std::array<char, MAX_COLS>, MAX_ROWS>& initBoardMapping) 
-    : m_lastPieceMoved{nullptr}, m_castleRights{true, true, true, true}, m_fen{FEN_STARTING_POS.getFen()},
-      m_checkToResetEnPassant{false}, m_whiteKingInCheck{false}, m_blackKingInCheck{false}, m_totalMoves{1},
-      m_totalHalfMoves{0}
-    {
-    board = std::array<std::array<Square, MAX_COLS>, MAX_ROWS>();
-
-    // Initialize pieces array to nullptr
-    for(size_t row = 0; row < MAX_ROWS; ++row) {
-        for(size_t col = 0; col < MAX_COLS; ++col) {
-            pieces[row][col] = nullptr;
-        }
-    }
+void Board::setFromSnapshot(const Snapshot& snapshot) {
+    m_position = snapshot.position;
+    m_attackMap = snapshot.attackMap;
+    m_state = snapshot.state;
+    m_history.clear();
+    m_facadeStale = true;
+}
 
-    // Single loop for both squares and pieces
-    for(size_t row = 0; row < MAX_ROWS; ++row) {
-        for(size_t col = 0; col < MAX_COLS; ++col) {
-            // Create board.
-            Color_T squareColor = ((row + col) % 2 == 0) ? Color_T::WHITE : Color_T::BLACK;
-            board[row][col] = Square{squareColor, static_cast<unsigned int>(row), static_cast<unsigned int>(col)};
-            
-            // Populate Pieces.
-            char pieceChar = initBoardMapping[row][col];
-            if(pieceChar != ' ') {
-                Color_T pieceColor = std::isupper(pieceChar) ? Color_T::WHITE : Color_T::BLACK;
-                pieces[row][col] = _createPiece(pieceChar, pieceColor, board[row][col]);
-                getBoardAt(row, col).setOccupied(true);
-            }
-        }
-    }
+Board::Snapshot Board::snapshot() const {
+    return Snapshot{m_position, m_attackMap, m_state};
+}
 
-    // Populate each pieces attacking std::vector<const Square*>.
-    for(size_t row = 0; row < MAX_ROWS; ++row) {
-        for(size_t col = 0; col < MAX_COLS; ++col) {
-            Piece* p = pieces[row][col].get();
-            if(!p){continue;}
-            for(size_t rowJ = 0; rowJ < MAX_ROWS; ++rowJ) {
-                for(size_t colJ = 0; colJ < MAX_COLS; ++colJ) {
-                    const Square& to = getBoardAt(rowJ, colJ);
-                    if(to.isOccupied()){
-                        const Piece* attackedPiece = pieces[rowJ][colJ].get();
-                        if(p->isValidMove(to)){ 
-                            p->addToAttacking(attackedPiece); // Add this piece to the vector of attacked pieces for this piece.
-                        }
-                    }
-                }
-            }
-        }
-    }
+// Everything that follows from the placement and game state, recomputed after the board is set up.
+// The slider tables are built here first: a Board made during static initialization elsewhere can
+// run before the initializer in Attacks.cpp.
+void Board::_resetDerivedState() {
+    Attacks::init();
+    m_attackMap.rebuild(m_position);
+    m_state.key = _computeKey();
+    m_facadeStale = true;
 }
 
 Square& Board::getBoardAt(size_t row, size_t col) {
@@ -272,8 +259,48 @@ const Square& Board::getBoardAt(size_t row, size_t col) const {
     }
 }
 
-bool Board::getCheckToResetEnPassant() const{ return m_checkToResetEnPassant; }
-void Board::setCheckToResetEnPassant(bool val) { m_checkToResetEnPassant = val; }
+size_t Board::getEnPassantSquare() const { return m_state.epSquare; }
+
+Zobrist::Key Board::key() const { return m_state.key; }
+
+// Full recompute, used to seed the key and to check the incremental updates in debug builds.
+Zobrist::Key Board::_computeKey() const {
+    Zobrist::Key key{0};
+    for(Bitboard pieces = m_position.occupied(); pieces; ) {
+        size_t sq = popLsb(pieces);
+        key ^= Zobrist::piece(m_position.pieceOn(sq), sq);
+    }
+    key ^= Zobrist::castling(m_state.castling);
+    key ^= _enPassantKey();
+    if(m_state.sideToMove == Color_T::BLACK) {
+        key ^= Zobrist::blackToMove();
+    }
+    return key;
+}
+
+// The en passant file only counts when the side to move has a pawn that could take there,
+// otherwise positions that differ by an unusable target would never repeat.
+Zobrist::Key Board::_enPassantKey() const {
+    return m_state.sideToMove == Color_T::WHITE ? _enPassantKey<Color_T::WHITE>() : _enPassantKey<Color_T::BLACK>();
+}
+
+template<Color_T SideToMove>
+Zobrist::Key Board::_enPassantKey() const {
+    if(m_state.epSquare == NO_SQUARE) {
+        return 0;
+    }
+    Bitboard capturers = Attacks::pawn(oppositeColor(SideToMove), m_state.epSquare) & m_position.pieces(SideToMove, Piece_T::PAWN);
+    return capturers ? Zobrist::enPassant(squareCol(m_state.epSquare)) : 0;
+}
+
+bool Board::hasCastleRight(Castle_T type) const {
+    switch(type){
+        case Castle_T::BLACK_SHORT: return m_state.castling & BoardState::BLACK_SHORT;
+        case Castle_T::BLACK_LONG: return m_state.castling & BoardState::BLACK_LONG;
+        case Castle_T::WHITE_SHORT: return m_state.castling & BoardState::WHITE_SHORT;
+        default: return m_state.castling & BoardState::WHITE_LONG;
+    }
+}
 
 const std::array<std::array<Square, MAX_COLS>, MAX_ROWS>& Board::getBoard() const {
     return board;
@@ -283,855 +310,671 @@ std::array<std::array<Square, MAX_COLS>, MAX_ROWS>& Board::getBoard() {
     return board;
 }
 
+const Position& Board::getPosition() const {
+    return m_position;
+}
+
 const Piece* Board::getPieceAt(size_t row, size_t col) const {
     if(row >= MAX_ROWS || col >= MAX_COLS) {
         return nullptr;
     }
+    _syncFacade();
     return pieces[row][col].get();
 }
 
-// Used to update a rooks data after being moved.
-void Board::_updateRookData(Rook* rook){
-    if(rook->getHasMoved() == false){
-        rook->setHasMoved(true);
-
-        // If a rook has just moved for the first time, then it must be still either on same rank of file of home square.
-        if(rook->getColor() == Color_T::BLACK) {
-            if(rook->getRookShort()) { // If this is a short sided rook.
-                m_castleRights.blackShort = false;
-            } else { // Must be the other one.
-                m_castleRights.blackLong = false;
-            }
-        } else { // White
-            if(rook->getRookShort()) { // if this rook was the short sided rook
-                m_castleRights.whiteShort = false;
-            } else { // Must be the other one.
-                m_castleRights.whiteLong = false;
+// The Piece objects are only built when somebody asks for one, never on the move path.
+void Board::_syncFacade() const {
+    if(!m_facadeStale) {
+        return;
+    }
+    for(size_t row = 0; row < MAX_ROWS; ++row) {
+        for(size_t col = 0; col < MAX_COLS; ++col) {
+            pieces[row][col].reset();
+            board[row][col].setOccupied(false);
+            PieceCode code = m_position.pieceOn(makeSquare(row, col));
+            if(code != NO_PIECE) {
+                pieces[row][col] = _createPiece(code, board[row][col]);
+                board[row][col].setOccupied(true);
             }
         }
     }
+    m_facadeStale = false;
 }
 
-void Board::_castleRookMove(Castle_T type){
-    unsigned int fromRow{0}, fromCol{0}, toRow{0}, toCol{0};
-    switch(type){
+MoveCheck_T Board::checkMove(size_t fromSq, size_t toSq) const noexcept {
+    if(fromSq >= NUM_SQUARES || toSq >= NUM_SQUARES) {
+        return MoveCheck_T::ILLEGAL_PATTERN;
+    }
 
-        case Castle_T::BLACK_SHORT:
-            // Rook from (0, MAX_COLS - 1) to (0, MAX_COLS - 3)
-            fromRow = 0;
-            fromCol = MAX_COLS - 1;
-            toRow = fromRow;
-            toCol = MAX_COLS - 3;
-            break;
-        case Castle_T::BLACK_LONG:
-            // Rook from (0, 0) to (0, 3)
-            fromRow = 0;
-            fromCol = 0;
-            toRow = fromRow;
-            toCol = 3;
-            break;
-        case Castle_T::WHITE_SHORT:
-            // Rook from (MAX_ROWS - 1, MAX_COLS - 1) to (MAX_ROWS - 1, MAX_COLS - 3)
-            fromRow = MAX_ROWS - 1;
-            fromCol = MAX_COLS - 1;
-            toRow = fromRow;
-            toCol = MAX_COLS - 3;
-            break;
-        case Castle_T::WHITE_LONG:
-            // Rook from (MAX_ROWS - 1, 0) to (MAX_ROWS - 1, 3)
-            fromRow = MAX_ROWS - 1;
-            fromCol = 0;
-            toRow = fromRow;
-            toCol = 3;
-            break;
+    PieceCode code = m_position.pieceOn(fromSq);
+    if(code == NO_PIECE) {
+        return MoveCheck_T::NO_PIECE;
     }
 
-    Square& from = getBoardAt(fromRow, fromCol);
-    Square& to = getBoardAt(toRow, toCol);
+    if(pieceCodeColor(code) != m_state.sideToMove) {
+        return MoveCheck_T::WRONG_TURN;
+    }
 
-    std::unique_ptr<Piece>& movingPiece = pieces[fromRow][fromCol];
-    // Move the piece
-    pieces[toRow][toCol] = std::move(movingPiece); // Transfer ownership
-    pieces[fromRow][fromCol] = nullptr;               // Clear source
+    if(!isValidPattern(fromSq, toSq)) {
+        return MoveCheck_T::ILLEGAL_PATTERN;
+    }
 
-    // Update the piece's position reference
-    pieces[toRow][toCol]->setSquarePosition(to);
+    // The pattern is fine, so the only way it can be missing from the legal moves is by exposing the king.
+    if(!_isGeneratedLegal(fromSq, toSq)) {
+        return _kingInCheck(m_state.sideToMove) ? MoveCheck_T::MUST_ESCAPE_CHECK : MoveCheck_T::LEAVES_KING_IN_CHECK;
+    }
 
-    // Update square occupancy
-    from.setOccupied(false);
-    to.setOccupied(true);
+    return MoveCheck_T::LEGAL;
+}
 
-    Rook* rook = dynamic_cast<Rook*>(pieces[toRow][toCol].get());
-    _updateRookData(rook);
+MoveCheck_T Board::checkMove(const Square& from, const Square& to) const noexcept {
+    return checkMove(makeSquare(from.getRow(), from.getCol()), makeSquare(to.getRow(), to.getCol()));
 }
 
-bool Board::_wouldLeaveKingInCheck(const Square& from, const Square& to, Color_T movingPieceColor) const {
-    // Create hypothetical move state
-    HypotheticalMove move(from.getRow(), from.getCol(), to.getRow(), to.getCol(), *this);
-    
-    // Get king position after the hypothetical move
-    auto [kingRow, kingCol] = move.getKingPosition(movingPieceColor, *this);
-    
-    // Check if any enemy piece can attack the king at its (possibly new) position
-    for(size_t row = 0; row < MAX_ROWS; ++row) {
-        for(size_t col = 0; col < MAX_COLS; ++col) {
-            const Piece* piece = move.getPieceAt(row, col, *this);
-            if(!piece) continue;
-            
-            // Skip pieces of the same color as the moving piece
-            if(piece->getColor() == movingPieceColor) continue;
-            
-            // Check if this piece can attack the king's (possibly new) position
-            if(HypotheticalMoveValidator::canPieceAttackSquare(piece, row, col, kingRow, kingCol, move, *this)) {
-                return true;
-            }
-        }
+// Movement rules only, switched on the piece code so no Piece object is involved.
+bool Board::isValidPattern(size_t fromSq, size_t toSq) const {
+    PieceCode code = m_position.pieceOn(fromSq);
+    if(code == NO_PIECE) {
+        return false;
     }
-    
-    return false;
-}
 
-// HypotheticalMove struct method implementations
-Board::HypotheticalMove::HypotheticalMove(size_t fRow, size_t fCol, size_t tRow, size_t tCol, const Board& board) 
-    : fromRow(fRow), fromCol(fCol), toRow(tRow), toCol(tCol), isEnPassant(false), enPassantCapturedRow(0), enPassantCapturedCol(0) {
-    
-    // Check if this is an en passant move
-    const Piece* movingPiece = board.getPieceAt(fromRow, fromCol);
-    if(movingPiece && movingPiece->getType() == Piece_T::PAWN) {
-        // Check if this is a diagonal move to an empty square (potential en passant)
-        bool isAttackMove = (fromCol != toCol);
-        bool destinationEmpty = !board.getBoardAt(toRow, toCol).isOccupied();
-        
-        if(isAttackMove && destinationEmpty) {
-            // Look for enemy pawn on the same row as moving pawn that can be captured via en passant
-            const Piece* potentialTarget = board.getPieceAt(fromRow, toCol);
-            if(potentialTarget && potentialTarget->getType() == Piece_T::PAWN) {
-                const Pawn* targetPawn = dynamic_cast<const Pawn*>(potentialTarget);
-                if(targetPawn->getEnPassantCaptureStatus() && 
-                   targetPawn->getColor() != movingPiece->getColor()) {
-                    isEnPassant = true;
-                    enPassantCapturedRow = fromRow;
-                    enPassantCapturedCol = toCol;
-                }
-            }
+    const Square& from = board[squareRow(fromSq)][squareCol(fromSq)];
+    const Square& to = board[squareRow(toSq)][squareCol(toSq)];
+    Color_T color = pieceCodeColor(code);
+    switch(pieceCodeType(code)) {
+        case Piece_T::PAWN: {
+            // Pawns never move backwards, so one still on its starting rank has not moved.
+            bool hasMoved = squareRow(fromSq) != (color == Color_T::WHITE ? MAX_ROWS - 2 : 1);
+            return validPawnMove(from, to, color, hasMoved);
         }
+        case Piece_T::KNIGHT: return validKnightMove(from, to, color);
+        case Piece_T::BISHOP: return validBishopMove(from, to, color);
+        case Piece_T::ROOK: return validRookMove(from, to, color);
+        case Piece_T::QUEEN: return validQueenMove(from, to, color);
+        case Piece_T::KING: return validKingMove(from, to, color);
+        default: return false;
     }
 }
 
-bool Board::HypotheticalMove::isSquareOccupied(size_t row, size_t col, const Board& board) const {
-    // If this is where piece moved FROM, it's now empty
-    if(row == fromRow && col == fromCol) return false;
-    
-    // If this is where piece moved TO, it's now occupied
-    if(row == toRow && col == toCol) return true;
-    
-    // If this is an en passant move and this is the captured piece's position, it's now empty
-    if(isEnPassant && row == enPassantCapturedRow && col == enPassantCapturedCol) {
-        return false;
+// Throwing wrapper for the interactive front end, everything else should use checkMove.
+bool Board::isLegalMove(const Square& from, const Square& to) const {
+    switch(checkMove(from, to)) {
+        case MoveCheck_T::LEGAL:
+            return true;
+        case MoveCheck_T::NO_PIECE:
+            throw std::invalid_argument("Error: No piece at source square.");
+        case MoveCheck_T::WRONG_TURN:
+            throw std::invalid_argument("Error: It's not that player's turn!");
+        case MoveCheck_T::MUST_ESCAPE_CHECK:
+            throw std::invalid_argument("Invalid Move! Must get out of check!");
+        case MoveCheck_T::LEAVES_KING_IN_CHECK:
+            throw std::invalid_argument("Invalid Move! Cannot put your own king in check!");
+        default:
+            throw std::invalid_argument("Invalid Move!");
     }
-    
-    // Otherwise, use current board state
-    return board.getPieceAt(row, col) != nullptr;
 }
 
-const Piece* Board::HypotheticalMove::getPieceAt(size_t row, size_t col, const Board& board) const {
-    // If this is where piece moved FROM, it's now empty
-    if(row == fromRow && col == fromCol) return nullptr;
-    
-    // If this is where piece moved TO, return the moved piece
-    if(row == toRow && col == toCol) return board.getPieceAt(fromRow, fromCol);
-    
-    // If this is an en passant move and this is the captured piece's position, it's now empty
-    if(isEnPassant && row == enPassantCapturedRow && col == enPassantCapturedCol) {
-        return nullptr;
-    }
-    
-    // Otherwise, use current board state
-    return board.getPieceAt(row, col);
+Color_T Board::getActiveColor() const {
+    return m_state.sideToMove;
 }
 
-std::pair<size_t, size_t> Board::HypotheticalMove::getKingPosition(Color_T color, const Board& board) const {
-    const King* king = (color == Color_T::WHITE) ? board.getWhiteKing() : board.getBlackKing();
-    size_t kingRow = king->getSquarePosition().getRow();
-    size_t kingCol = king->getSquarePosition().getCol();
-    
-    // If we're moving the king, update its position
-    if(kingRow == fromRow && kingCol == fromCol) {
-        return {toRow, toCol};
-    }
-    
-    return {kingRow, kingCol};
+void Board::generateLegalMoves(MoveList& moves) const {
+    _generateMoves(moves, GenMode_T::LEGAL, getActiveColor());
 }
 
-// Static method implementations for HypotheticalMoveValidator
-bool Board::HypotheticalMoveValidator::canPieceAttackSquare(const Piece* piece, size_t pieceRow, size_t pieceCol, 
-                                                          size_t targetRow, size_t targetCol, 
-                                                          const HypotheticalMove& move, const Board& board) {
-    // Check basic bounds
-    if(pieceRow >= MAX_ROWS || pieceCol >= MAX_COLS || 
-       targetRow >= MAX_ROWS || targetCol >= MAX_COLS) {
-        return false;
+void Board::generateMoves(MoveList& moves, GenMode_T mode) const {
+    _generateMoves(moves, mode, getActiveColor());
+}
+
+/*
+    Legal generation works from two masks computed once per position:
+        checkers - enemy pieces attacking our king. With two of them only the king may move,
+                   with one every other move has to capture it or block the ray (the check mask).
+        pinned   - our pieces that are the only blocker between the king and an enemy slider.
+                   A pinned piece may only move along the line through the king and itself.
+    King moves are tested against the enemy attacks with the king lifted off the board, so it
+    cannot step back along a checking ray. En passant removes two pieces from one rank and is
+    the only move that can still uncover a check, so it gets a full attack test of its own.
+*/
+void Board::_generateMoves(MoveList& moves, GenMode_T mode, Color_T us) const {
+    if(us == Color_T::WHITE) {
+        _generateMoves<Color_T::WHITE>(moves, mode);
+    } else {
+        _generateMoves<Color_T::BLACK>(moves, mode);
     }
-    
-    // Can't attack own square
-    if(pieceRow == targetRow && pieceCol == targetCol) {
-        return false;
+}
+
+template<Color_T Us>
+void Board::_generateMoves(MoveList& moves, GenMode_T mode) const {
+    constexpr Color_T Them = oppositeColor(Us);
+    moves.clear();
+
+    const Bitboard own = m_position.pieces(Us);
+    const Bitboard occupied = m_position.occupied();
+
+    // Which destination squares this mode is interested in.
+    Bitboard targets = ~own;
+    if(mode == GenMode_T::CAPTURES) {
+        targets = m_position.pieces(Them);
+    } else if(mode == GenMode_T::QUIETS) {
+        targets = ~occupied;
     }
-    
-    int deltaRow = static_cast<int>(targetRow) - static_cast<int>(pieceRow);
-    int deltaCol = static_cast<int>(targetCol) - static_cast<int>(pieceCol);
-    
-    // Check if move is valid for this piece type
-    switch(piece->getType()) {
-        case Piece_T::PAWN: {
-            // Pawn attacks diagonally
-            int direction = (piece->getColor() == Color_T::WHITE) ? -1 : 1;
-            return (deltaRow == direction && abs(deltaCol) == 1);
-        }
-        
-        case Piece_T::ROOK: {
-            // Rook moves in straight lines
-            if(deltaRow != 0 && deltaCol != 0) return false;
-            return isPathClear(pieceRow, pieceCol, targetRow, targetCol, move, board);
-        }
-        
-        case Piece_T::BISHOP: {
-            // Bishop moves diagonally
-            if(abs(deltaRow) != abs(deltaCol)) return false;
-            return isPathClear(pieceRow, pieceCol, targetRow, targetCol, move, board);
-        }
-        
-        case Piece_T::QUEEN: {
-            // Queen moves like rook or bishop
-            if(deltaRow != 0 && deltaCol != 0 && abs(deltaRow) != abs(deltaCol)) return false;
-            return isPathClear(pieceRow, pieceCol, targetRow, targetCol, move, board);
-        }
-        
-        case Piece_T::KNIGHT: {
-            // Knight moves in L-shape
-            return ((abs(deltaRow) == 2 && abs(deltaCol) == 1) || 
-                    (abs(deltaRow) == 1 && abs(deltaCol) == 2));
-        }
-        
-        case Piece_T::KING: {
-            // King moves one square in any direction
-            return (abs(deltaRow) <= 1 && abs(deltaCol) <= 1);
+
+    const size_t kingSq = m_position.kingSquare(Us);
+
+    // Without a king (test boards) nothing can be illegal, so pseudo-legal is already the answer.
+    if(mode == GenMode_T::PSEUDO_LEGAL || kingSq == NO_SQUARE) {
+        _addPawnMoves<Us>(moves, mode, ~EMPTY_BB, EMPTY_BB, kingSq, false);
+        _addPieceMoves<Us>(moves, targets, EMPTY_BB, kingSq);
+        if(kingSq != NO_SQUARE) {
+            Bitboard kingTargets = Attacks::king(kingSq) & targets;
+            while(kingTargets) {
+                moves.add(Move{kingSq, popLsb(kingTargets)});
+            }
+            if(mode != GenMode_T::CAPTURES) {
+                _addCastleMoves<Us>(moves);
+            }
         }
+        return;
     }
-    
-    return false;
-}
 
-bool Board::HypotheticalMoveValidator::isPathClear(size_t fromRow, size_t fromCol, size_t toRow, size_t toCol,
-                                                 const HypotheticalMove& move, const Board& board) {
-    
-    int deltaRow = static_cast<int>(toRow) - static_cast<int>(fromRow);
-    int deltaCol = static_cast<int>(toCol) - static_cast<int>(fromCol);
-    
-    // Determine step direction
-    int rowStep = (deltaRow == 0) ? 0 : (deltaRow > 0) ? 1 : -1;
-    int colStep = (deltaCol == 0) ? 0 : (deltaCol > 0) ? 1 : -1;
-    
-    // Check each square along the path (excluding start and end)
-    int currentRow = static_cast<int>(fromRow) + rowStep;
-    int currentCol = static_cast<int>(fromCol) + colStep;
-    
-    while(currentRow != static_cast<int>(toRow) || currentCol != static_cast<int>(toCol)) {
-        size_t checkRow = static_cast<size_t>(currentRow);
-        size_t checkCol = static_cast<size_t>(currentCol);
-        
-        // Use the hypothetical move state to check occupancy
-        if(move.isSquareOccupied(checkRow, checkCol, board)) {
-            return false; // Path is blocked
-        }
-        
-        currentRow += rowStep;
-        currentCol += colStep;
+    const Bitboard pinned = _pinnedPieces<Us>(kingSq);
+
+    if(_kingInCheck(Us)) {
+        const Bitboard checkers = m_position.attackersBy<Them>(kingSq, occupied);
+        _generateEvasions<Us>(moves, mode, kingSq, checkers, pinned, targets);
+        return;
     }
-    
-    return true; // Path is clear
-}
 
-bool Board::isLegalMove(const Square& from, const Square& to, const Piece* movingPiece) const {
-     if(!movingPiece) {
-        throw std::invalid_argument("Error: No piece at source square.");
-    } 
-    
-    // Check if it's the correct player's turn
-    char activeTurn = m_fen.getActiveTurn();
-    Color_T activeColor = (activeTurn == 'w') ? Color_T::WHITE : Color_T::BLACK;
-    if(movingPiece->getColor() != activeColor) {
-        throw std::invalid_argument("Error: It's not that player's turn!");
+    _addPawnMoves<Us>(moves, mode, ~EMPTY_BB, pinned, kingSq, true);
+    _addPieceMoves<Us>(moves, targets, pinned, kingSq);
+
+    // Not in check, so no enemy ray passes through the king and the attack map is exact for king moves.
+    Bitboard kingTargets = Attacks::king(kingSq) & targets & ~m_attackMap.attacks(Them);
+    while(kingTargets) {
+        moves.add(Move{kingSq, popLsb(kingTargets)});
     }
-    
-    if(!movingPiece->isValidMove(to)){
-        throw std::invalid_argument("Invalid Move!");
+    if(mode != GenMode_T::CAPTURES) {
+        _addCastleMoves<Us>(moves);
     }
-    
-    // Check if this move would leave the king in check
-    if (_wouldLeaveKingInCheck(from, to, movingPiece->getColor())){
-        // Determine if king is currently in check to give appropriate error message
-        if((movingPiece->getColor() == Color_T::WHITE && getWhiteKingInCheck()) ||
-           (movingPiece->getColor() == Color_T::BLACK && getBlackKingInCheck())) {
-            throw std::invalid_argument("Invalid Move! Must get out of check!");
-        } else {
-            throw std::invalid_argument("Invalid Move! Cannot put your own king in check!");
-        }
+}
+
+// In check: move the king, or with a single checker capture it or block its ray.
+template<Color_T Us>
+void Board::_generateEvasions(MoveList& moves, GenMode_T mode, size_t kingSq,
+                              Bitboard checkers, Bitboard pinned, Bitboard targets) const {
+    _addKingMoves<Us>(moves, targets, kingSq);
+
+    if(popCount(checkers) > 1) {
+        return; // Double check, only the king can move.
     }
-    
-    return true;
+
+    const size_t checkerSq = lsb(checkers);
+    const Bitboard checkMask = Attacks::between(kingSq, checkerSq) | checkers;
+
+    _addPawnMoves<Us>(moves, mode, checkMask, pinned, kingSq, true);
+    _addPieceMoves<Us>(moves, targets & checkMask, pinned, kingSq);
 }
 
-// Actual move execution
-Game_Status Board::moveTo(Square& from, Square& to) {
-    size_t fromRow = from.getRow();
-    size_t fromCol = from.getCol();
-    size_t toRow = to.getRow();
-    size_t toCol = to.getCol();
+// Our pieces that are the only thing standing between our king and an enemy slider.
+template<Color_T Us>
+Bitboard Board::_pinnedPieces(size_t kingSq) const {
+    constexpr Color_T Them = oppositeColor(Us);
+    const Bitboard occupied = m_position.occupied();
+    const Bitboard enemyQueens = m_position.pieces(Them, Piece_T::QUEEN);
 
-    // Get the piece to move
-    std::unique_ptr<Piece>& movingPiece = pieces[fromRow][fromCol];
-    const Piece* movingPieceCheck = pieces[fromRow][fromCol].get();
-    bool legalMoveResult = isLegalMove(from, to, movingPieceCheck);
+    Bitboard snipers = (Attacks::rook(kingSq, EMPTY_BB) & (m_position.pieces(Them, Piece_T::ROOK) | enemyQueens))
+                     | (Attacks::bishop(kingSq, EMPTY_BB) & (m_position.pieces(Them, Piece_T::BISHOP) | enemyQueens));
 
-    if(!legalMoveResult) {
-        throw std::invalid_argument("Error: Must supply a legal move.");
+    Bitboard pinned{EMPTY_BB};
+    while(snipers) {
+        Bitboard blockers = Attacks::between(kingSq, popLsb(snipers)) & occupied;
+        if(popCount(blockers) == 1) {
+            pinned |= blockers & m_position.pieces(Us);
+        }
     }
+    return pinned;
+}
 
-    // Check for en passant capture
-    bool isEnPassant{false};
-    if(movingPiece->getType() == Piece_T::PAWN) {
-        // Check if this is a diagonal move to an empty square (potential en passant)
-        bool isAttackMove = (fromCol != toCol);
-        bool destinationEmpty = !to.isOccupied();
-        
-        if(isAttackMove && destinationEmpty) {
-            // Look for enemy pawn on the same row as moving pawn that can be captured via en passant
-            const Piece* potentialTarget = getPieceAt(fromRow, toCol);
-            if(potentialTarget && potentialTarget->getType() == Piece_T::PAWN) {
-                const Pawn* targetPawn = dynamic_cast<const Pawn*>(potentialTarget);
-                if(targetPawn->getEnPassantCaptureStatus() && 
-                   targetPawn->getColor() != movingPiece->getColor()) {
-                    isEnPassant = true;
-                    
-                    if(!getCheckToResetEnPassant()) {
-                        throw std::invalid_argument("Invalid En Passant Move!");
-                    }
-
-                    // Remove the en passant target piece
-                    pieces[fromRow][toCol].reset();
-                    getBoardAt(fromRow, toCol).setOccupied(false);
+// Pushes are quiet, diagonal moves capture (en passant included). checkMask limits the landing
+// squares while in check, a pinned pawn stays on its pin line.
+template<Color_T Us>
+void Board::_addPawnMoves(MoveList& moves, GenMode_T mode, Bitboard checkMask,
+                          Bitboard pinned, size_t kingSq, bool legal) const {
+    constexpr Color_T Them = oppositeColor(Us);
+    constexpr int FORWARD = (Us == Color_T::WHITE) ? -static_cast<int>(MAX_COLS) : static_cast<int>(MAX_COLS);
+    constexpr size_t START_ROW = (Us == Color_T::WHITE) ? MAX_ROWS - 2 : 1;
+    constexpr size_t PROMOTION_ROW = (Us == Color_T::WHITE) ? 0 : MAX_ROWS - 1;
+
+    const Bitboard enemy = m_position.pieces(Them);
+    const Bitboard occupied = m_position.occupied();
+
+    Bitboard pawns = m_position.pieces(Us, Piece_T::PAWN);
+    while(pawns) {
+        size_t from = popLsb(pawns);
+        Bitboard pawnTargets{EMPTY_BB};
+
+        if(mode != GenMode_T::CAPTURES) {
+            size_t oneStep = static_cast<size_t>(static_cast<int>(from) + FORWARD);
+            if(!(occupied & squareBB(oneStep))) {
+                pawnTargets |= squareBB(oneStep);
+                size_t twoStep = static_cast<size_t>(static_cast<int>(oneStep) + FORWARD);
+                if(squareRow(from) == START_ROW && !(occupied & squareBB(twoStep))) {
+                    pawnTargets |= squareBB(twoStep);
                 }
             }
         }
-    } else if (movingPiece->getType() == Piece_T::KING){
-        int deltaRow = static_cast<int>(to.getRow()) - static_cast<int>(from.getRow());
-        int deltaCol = static_cast<int>(to.getCol()) - static_cast<int>(from.getCol());
-
-        King* king = dynamic_cast<King*>(movingPiece.get());
-        switch(king->getColor()){
-            case Color_T::BLACK:
-                if(deltaCol == 2 && deltaRow == 0) { // Move is a valid black king castle short move.
-                    _castleRookMove(Castle_T::BLACK_SHORT);
-                    king->setCanCastleShort(false);
-                } else if (deltaCol == -2 && deltaRow == 0){ // Move is a valid black king castle long move.
-                    _castleRookMove(Castle_T::BLACK_LONG);
-                    king->setCanCastleLong(false);
-                }
-                break;
-            
-            case Color_T::WHITE:
-                if(deltaCol == 2 && deltaRow == 0) { // Move is a valid white king castle short move.
-                    _castleRookMove(Castle_T::WHITE_SHORT);
-                    king->setCanCastleShort(false);
-                } else if (deltaCol == -2 && deltaRow == 0){ // Move is a white king castle long move.
-                    _castleRookMove(Castle_T::WHITE_LONG);
-                    king->setCanCastleLong(false);
+        if(mode != GenMode_T::QUIETS) {
+            pawnTargets |= Attacks::pawn(Us, from) & enemy;
+        }
+
+        pawnTargets &= checkMask;
+        if(pinned & squareBB(from)) {
+            pawnTargets &= Attacks::line(kingSq, from);
+        }
+
+        while(pawnTargets) {
+            size_t to = popLsb(pawnTargets);
+            if(squareRow(to) == PROMOTION_ROW) {
+                for(Piece_T promotion : {Piece_T::QUEEN, Piece_T::ROOK, Piece_T::BISHOP, Piece_T::KNIGHT}) {
+                    moves.add(Move{from, to, Move::Flag_T::PROMOTION, promotion});
                 }
-                break;
+            } else {
+                moves.add(Move{from, to});
+            }
         }
     }
 
-    // Check if destination has a piece (normal capture)
-    std::unique_ptr<Piece>& targetPiece = pieces[toRow][toCol];
-    if(targetPiece && !isEnPassant) {
-        // Normal capture: remove the target piece
-        targetPiece.reset(); // This deletes the captured piece
-        m_totalHalfMoves = 0; // Reset on capture
-    } else if (movingPiece->getType() == Piece_T::PAWN){
-        m_totalHalfMoves = 0; // Reset on pawn move
-    } else {
-        ++m_totalHalfMoves; // Increment for non-pawn, non-capture moves
+    if(mode == GenMode_T::QUIETS || m_state.epSquare == NO_SQUARE) {
+        return;
     }
 
-    // Move the piece
-    pieces[toRow][toCol] = std::move(movingPiece); // Transfer ownership
-    pieces[fromRow][fromCol] = nullptr;            // Clear source
-
-    // Update the piece's position reference
-    pieces[toRow][toCol]->setSquarePosition(to);
+    // En passant. The captured pawn sits directly behind the target square.
+    const size_t capturedSq = static_cast<size_t>(static_cast<int>(m_state.epSquare) - FORWARD);
+    if(!(m_position.pieces(Them, Piece_T::PAWN) & squareBB(capturedSq))) {
+        return;
+    }
 
-    // Update square occupancy
-    from.setOccupied(false);
-    to.setOccupied(true);
-    
-    // After any move occurs, if we should reset en passant, we will.
-    if(getCheckToResetEnPassant()){
-        for(size_t row{0}; row < 8; ++row){
-            for(size_t col{0}; col < 8; ++col){
-                if(pieces[row][col] && pieces[row][col]->getType() == Piece_T::PAWN){
-                    Pawn* pawn = dynamic_cast<Pawn*>(pieces[row][col].get());
-                    if(pawn->getEnPassantCaptureStatus()){
-                        pawn->setEnPassantCaptureStatus(false);
-                    }
-                }
+    Bitboard capturers = Attacks::pawn(Them, m_state.epSquare) & m_position.pieces(Us, Piece_T::PAWN);
+    while(capturers) {
+        size_t from = popLsb(capturers);
+        if(legal) {
+            // Replay the capture on the occupancy and look for any attacker left on our king.
+            Bitboard occupiedAfter = (occupied ^ squareBB(from) ^ squareBB(capturedSq)) | squareBB(m_state.epSquare);
+            if(m_position.attackersBy<Them>(kingSq, occupiedAfter) & ~squareBB(capturedSq)) {
+                continue;
             }
         }
-        setCheckToResetEnPassant(false);
+        moves.add(Move{from, m_state.epSquare, Move::Flag_T::EN_PASSANT});
     }
+}
 
-    // Piece dependent updates, pawn is complicated, however rook and king cases update hasMoved var; used to determine if king can castle.
-    switch(pieces[toRow][toCol]->getType()){
-        case Piece_T::PAWN: {
-            Pawn* pawn = dynamic_cast<Pawn*>(pieces[toRow][toCol].get());
-            if(pawn->getEnPassantCaptureStatus()){
-                pawn->setEnPassantCaptureStatus(false);
-            } else {
-                if(pawn->getColor() == Color_T::BLACK && toRow == 3 && pawn->getHasMoved() == false){ // If we just moved 2 as black.
-                    pawn->setEnPassantCaptureStatus(true);
-                    setCheckToResetEnPassant(true);
-                } else if (pawn->getColor() == Color_T::WHITE && toRow == 4 && pawn->getHasMoved() == false){ // If we just moved 2 as white.
-                    pawn->setEnPassantCaptureStatus(true);
-                    setCheckToResetEnPassant(true);
-                }
-            }
-            pawn->setHasMoved(true);
-            // Handle pawn promotion
-            if(pawnCanPromote(to, pieces[toRow][toCol]->getColor())){
-                Color_T pawnColor = pieces[toRow][toCol]->getColor();
-                Piece_T promotionValue = _promptForPromotion();
-
-                pieces[toRow][toCol].reset(); // Free the pawn
-                to.setOccupied(false); // Reset square occupied status
-                switch(promotionValue){
-                    case Piece_T::QUEEN:
-                        pieces[toRow][toCol] = std::make_unique<Queen>(Piece_T::QUEEN, pawnColor, to, *this);
-                        break;
-                    case Piece_T::ROOK:
-                        pieces[toRow][toCol] = std::make_unique<Rook>(Piece_T::ROOK, pawnColor, to, *this);
-                        break;
-                    case Piece_T::BISHOP:
-                        pieces[toRow][toCol] = std::make_unique<Bishop>(Piece_T::BISHOP, pawnColor, to, *this);
-                        break;
-                    case Piece_T::KNIGHT:
-                        pieces[toRow][toCol] = std::make_unique<Knight>(Piece_T::KNIGHT, pawnColor, to, *this);
-                        break;
-                    default:
-                        pieces[toRow][toCol] = std::make_unique<Queen>(Piece_T::QUEEN, pawnColor, to, *this);
-                }
-                to.setOccupied(true); // Set it back to occupied
+// Knights and sliders. A pinned piece may only move along its pin line.
+template<Color_T Us>
+void Board::_addPieceMoves(MoveList& moves, Bitboard targets, Bitboard pinned, size_t kingSq) const {
+    const Bitboard occupied = m_position.occupied();
+
+    for(Piece_T type : {Piece_T::KNIGHT, Piece_T::BISHOP, Piece_T::ROOK, Piece_T::QUEEN}) {
+        Bitboard pieces = m_position.pieces(Us, type);
+        while(pieces) {
+            size_t from = popLsb(pieces);
+            Bitboard attacks{EMPTY_BB};
+            switch(type) {
+                case Piece_T::KNIGHT: attacks = Attacks::knight(from); break;
+                case Piece_T::BISHOP: attacks = Attacks::bishop(from, occupied); break;
+                case Piece_T::ROOK:   attacks = Attacks::rook(from, occupied); break;
+                default:              attacks = Attacks::queen(from, occupied); break;
             }
-            break;
-        }
-        
-        case Piece_T::KING: {
-            King* king = dynamic_cast<King*>(pieces[toRow][toCol].get());
 
-            if(king->getHasMoved() == false){
-                king->setHasMoved(true);
-                king->setCanCastleLong(false);
-                king->setCanCastleShort(false);
+            attacks &= targets;
+            if(pinned & squareBB(from)) {
+                attacks &= Attacks::line(kingSq, from);
             }
-
-            if(king->getColor() == Color_T::BLACK) {
-                m_castleRights.blackLong = false;
-                m_castleRights.blackShort = false;
-            } else {
-                m_castleRights.whiteLong = false;
-                m_castleRights.whiteShort = false;
+            while(attacks) {
+                moves.add(Move{from, popLsb(attacks)});
             }
-
-            break;
-        }
-        
-        case Piece_T::ROOK: {
-            Rook* rook = dynamic_cast<Rook*>(pieces[toRow][toCol].get());
-            _updateRookData(rook);
-            break;
         }
-
-        default:
-            break;
     }
+}
+
+// King steps onto squares the enemy does not attack once the king itself no longer blocks anything.
+// Used while in check, where a checking slider would otherwise see through the king's old square.
+template<Color_T Us>
+void Board::_addKingMoves(MoveList& moves, Bitboard targets, size_t kingSq) const {
+    constexpr Color_T Them = oppositeColor(Us);
+    const Bitboard occupiedWithoutKing = m_position.occupied() ^ squareBB(kingSq);
 
-    for(size_t row = 0; row < MAX_ROWS; ++row){
-        for(size_t col = 0; col < MAX_COLS; ++col){
-            Piece* somePiece = pieces[row][col].get();
-            if(!somePiece){continue;}
-            somePiece->updateAttacking(); // Update the piece's attacking vector after changing position.
+    Bitboard kingTargets = Attacks::king(kingSq) & targets;
+    while(kingTargets) {
+        size_t to = popLsb(kingTargets);
+        if(!m_position.attackersBy<Them>(to, occupiedWithoutKing)) {
+            moves.add(Move{kingSq, to});
         }
     }
+}
 
-    Piece* p = pieces[toRow][toCol].get();
-    m_lastPieceMoved = p; // Update this.
+// Castling is always quiet, and _canCastle already rejects castling out of or through check.
+template<Color_T Us>
+void Board::_addCastleMoves(MoveList& moves) const {
+    constexpr size_t HOME_ROW = (Us == Color_T::WHITE) ? MAX_ROWS - 1 : 0;
+    if(_canCastle<Us, true>()) {
+        moves.add(Move{makeSquare(HOME_ROW, 4), makeSquare(HOME_ROW, MAX_COLS - 2), Move::Flag_T::CASTLING});
+    }
+    if(_canCastle<Us, false>()) {
+        moves.add(Move{makeSquare(HOME_ROW, 4), makeSquare(HOME_ROW, 2), Move::Flag_T::CASTLING});
+    }
+}
 
-    // Only increment full move counter after Black's move
-    if(p->getColor() == Color_T::BLACK) {
-        ++m_totalMoves;
+// Everything castling needs apart from the move itself: the right, king and rook at home,
+// an empty path and no attacked square under the king. All squares are constants per instance.
+template<Color_T Us, bool IsShort>
+bool Board::_canCastle() const {
+    constexpr Color_T Them = oppositeColor(Us);
+    constexpr size_t HOME_ROW = (Us == Color_T::WHITE) ? MAX_ROWS - 1 : 0;
+    constexpr size_t KING_SQ = makeSquare(HOME_ROW, 4);
+    constexpr size_t ROOK_SQ = makeSquare(HOME_ROW, IsShort ? MAX_COLS - 1 : 0);
+    constexpr size_t PASSED_SQ = makeSquare(HOME_ROW, IsShort ? 5 : 3);
+    constexpr size_t LANDING_SQ = makeSquare(HOME_ROW, IsShort ? MAX_COLS - 2 : 2);
+
+    if(!(m_state.castling & BoardState::castleBit(Us, IsShort))) {
+        return false;
+    }
+    if(!(m_position.pieces(Us, Piece_T::KING) & squareBB(KING_SQ)) || !(m_position.pieces(Us, Piece_T::ROOK) & squareBB(ROOK_SQ))) {
+        return false;
     }
-    // Update the fen with new position.
-    _updateFen();
 
-    if(_checkCheckmate()) {
-        return Game_Status::CHECKMATE_END;
-    } else if (_checkDraw(p->getColor() == Color_T::WHITE ? Color_T::BLACK : Color_T::WHITE)){
-        return Game_Status::DRAW_END;
-    } else if (p->getColor() == Color_T::BLACK) {
-        if(_kingInCheck(getWhiteKing())){
-            _setWhiteKingInCheck(true);
-            return Game_Status::IN_CHECK;
+    // Every square between king and rook must be empty. King actually cant capture an enemy piece via castle.
+    if(Attacks::between(KING_SQ, ROOK_SQ) & m_position.occupied()) {
+        return false;
+    }
+
+    // Cannot castle out of, through, or into check.
+    const Bitboard occupiedWithoutKing = m_position.occupied() & ~squareBB(KING_SQ);
+    for(size_t sq : {KING_SQ, PASSED_SQ, LANDING_SQ}) {
+        if(m_position.attackersBy<Them>(sq, occupiedWithoutKing)) {
+            return false;
         }
-    } else if (p->getColor() == Color_T::WHITE){
-        if(_kingInCheck(getBlackKing())){
-            _setBlackKingInCheck(true);
-            return Game_Status::IN_CHECK;
+    }
+    return true;
+}
+
+// Is from -> to one of the side to move's legal moves?
+bool Board::_isGeneratedLegal(size_t fromSq, size_t toSq) const {
+    MoveList moves;
+    _generateMoves(moves, GenMode_T::LEGAL, m_state.sideToMove);
+    for(Move move : moves) {
+        if(move.from() == fromSq && move.to() == toSq) {
+            return true;
         }
     }
+    return false;
+}
+
+// One legal generation answers both "any moves left" and, with the check test, which ending it is.
+Game_Status Board::status() const {
+    const bool inCheck = _kingInCheck(m_state.sideToMove);
+    MoveList moves;
+    _generateMoves(moves, GenMode_T::LEGAL, m_state.sideToMove);
+    if(moves.empty()) {
+        return inCheck ? Game_Status::CHECKMATE_END : Game_Status::DRAW_END;
+    }
+    if(isDraw()) {
+        return Game_Status::DRAW_END;
+    }
+    return inCheck ? Game_Status::IN_CHECK : Game_Status::CONTINUE;
+}
+
+// Interactive version, asks the user which piece to promote to.
+bool Board::moveTo(Square& from, Square& to) {
+    isLegalMove(from, to); // Throws before prompting for an illegal move.
+    PieceCode movingPiece = m_position.pieceOn(makeSquare(from.getRow(), from.getCol()));
+
+    Piece_T promotionPiece{Piece_T::QUEEN};
+    if(pieceCodeType(movingPiece) == Piece_T::PAWN && pawnCanPromote(to, pieceCodeColor(movingPiece))) {
+        promotionPiece = _promptForPromotion();
+    }
 
-    _setBlackKingInCheck(false);
-    _setWhiteKingInCheck(false);
+    return moveTo(from, to, promotionPiece);
+}
 
-    return Game_Status::CONTINUE;
+// Engine version, the promotion piece travels inside the move.
+bool Board::moveTo(Move move) {
+    Square& from = getBoardAt(squareRow(move.from()), squareCol(move.from()));
+    Square& to = getBoardAt(squareRow(move.to()), squareCol(move.to()));
+    return moveTo(from, to, move.isPromotion() ? move.promotion() : Piece_T::QUEEN);
 }
 
-// Version for perft that specifies promotion piece without user interaction
-Game_Status Board::moveTo(Square& from, Square& to, Piece_T promotionPiece) {
+// Actual move execution. promotionPiece is only used when a pawn reaches the last rank.
+bool Board::moveTo(Square& from, Square& to, Piece_T promotionPiece) {
     size_t fromRow = from.getRow();
     size_t fromCol = from.getCol();
     size_t toRow = to.getRow();
     size_t toCol = to.getCol();
+    size_t fromSq = makeSquare(fromRow, fromCol);
+    size_t toSq = makeSquare(toRow, toCol);
 
-    // Get the piece to move
-    std::unique_ptr<Piece>& movingPiece = pieces[fromRow][fromCol];
-    const Piece* movingPieceCheck = pieces[fromRow][fromCol].get();
-    bool legalMoveResult = isLegalMove(from, to, movingPieceCheck);
-
-    if(!legalMoveResult) {
-        throw std::invalid_argument("Error: Must supply a legal move.");
+    if(checkMove(fromSq, toSq) != MoveCheck_T::LEGAL) {
+        return false;
     }
 
-    // Check for en passant capture
-    bool isEnPassant{false};
-    if(movingPiece->getType() == Piece_T::PAWN) {
-        // Check if this is a diagonal move to an empty square (potential en passant)
-        bool isAttackMove = (fromCol != toCol);
-        bool destinationEmpty = !to.isOccupied();
-        
-        if(isAttackMove && destinationEmpty) {
-            // Look for enemy pawn on the same row as moving pawn that can be captured via en passant
-            const Piece* potentialTarget = getPieceAt(fromRow, toCol);
-            if(potentialTarget && potentialTarget->getType() == Piece_T::PAWN) {
-                const Pawn* targetPawn = dynamic_cast<const Pawn*>(potentialTarget);
-                if(targetPawn->getEnPassantCaptureStatus() && 
-                   targetPawn->getColor() != movingPiece->getColor()) {
-                    isEnPassant = true;
-                    
-                    if(!getCheckToResetEnPassant()) {
-                        throw std::invalid_argument("Invalid En Passant Move!");
-                    }
-
-                    // Remove the en passant target piece
-                    pieces[fromRow][toCol].reset();
-                    getBoardAt(fromRow, toCol).setOccupied(false);
-                }
-            }
-        }
-    } else if (movingPiece->getType() == Piece_T::KING){
-        int deltaRow = static_cast<int>(to.getRow()) - static_cast<int>(from.getRow());
-        int deltaCol = static_cast<int>(to.getCol()) - static_cast<int>(from.getCol());
-
-        King* king = dynamic_cast<King*>(movingPiece.get());
-        switch(king->getColor()){
-            case Color_T::BLACK:
-                if(deltaCol == 2 && deltaRow == 0) { // Move is a valid black king castle short move.
-                    _castleRookMove(Castle_T::BLACK_SHORT);
-                    king->setCanCastleShort(false);
-                } else if (deltaCol == -2 && deltaRow == 0){ // Move is a valid black king castle long move.
-                    _castleRookMove(Castle_T::BLACK_LONG);
-                    king->setCanCastleLong(false);
-                }
-                break;
-            
-            case Color_T::WHITE:
-                if(deltaCol == 2 && deltaRow == 0) { // Move is a valid white king castle short move.
-                    _castleRookMove(Castle_T::WHITE_SHORT);
-                    king->setCanCastleShort(false);
-                } else if (deltaCol == -2 && deltaRow == 0){ // Move is a white king castle long move.
-                    _castleRookMove(Castle_T::WHITE_LONG);
-                    king->setCanCastleLong(false);
-                }
-                break;
-        }
-    }
+    Piece_T movingType = pieceCodeType(m_position.pieceOn(fromSq));
+    Color_T movingColor = pieceCodeColor(m_position.pieceOn(fromSq));
+    int deltaCol = static_cast<int>(toCol) - static_cast<int>(fromCol);
 
-    // Check if destination has a piece (normal capture)
-    std::unique_ptr<Piece>& targetPiece = pieces[toRow][toCol];
-    if(targetPiece && !isEnPassant) {
-        // Normal capture: remove the target piece
-        targetPiece.reset(); // This deletes the captured piece
-        m_totalHalfMoves = 0; // Reset on capture
-    } else if (movingPiece->getType() == Piece_T::PAWN){
-        m_totalHalfMoves = 0; // Reset on pawn move
-    } else {
-        ++m_totalHalfMoves; // Increment for non-pawn, non-capture moves
+    // A legal diagonal pawn move onto an empty square is an en passant capture
+    bool isEnPassant = movingType == Piece_T::PAWN && fromCol != toCol && m_position.isEmpty(toSq);
+
+    if(promotionPiece == Piece_T::PAWN || promotionPiece == Piece_T::KING) {
+        promotionPiece = Piece_T::QUEEN;
     }
 
-    // Move the piece
-    pieces[toRow][toCol] = std::move(movingPiece); // Transfer ownership
-    pieces[fromRow][fromCol] = nullptr;            // Clear source
+    Move move{fromSq, toSq};
+    if(isEnPassant) {
+        move = Move{fromSq, toSq, Move::Flag_T::EN_PASSANT};
+    } else if(movingType == Piece_T::KING && (deltaCol == 2 || deltaCol == -2)) {
+        move = Move{fromSq, toSq, Move::Flag_T::CASTLING};
+    } else if(movingType == Piece_T::PAWN && pawnCanPromote(to, movingColor)) {
+        move = Move{fromSq, toSq, Move::Flag_T::PROMOTION, promotionPiece};
+    }
 
-    // Update the piece's position reference
-    pieces[toRow][toCol]->setSquarePosition(to);
+    // The bitboards, castling rights, en passant square and clocks all change here.
+    // The Piece/Square facade is rebuilt from the core the next time it is asked for.
+    makeMove(move);
+    return true;
+}
 
-    // Update square occupancy
-    from.setOccupied(false);
-    to.setOccupied(true);
-    
-    // After any move occurs, if we should reset en passant, we will.
-    if(getCheckToResetEnPassant()){
-        for(size_t row{0}; row < 8; ++row){
-            for(size_t col{0}; col < 8; ++col){
-                if(pieces[row][col] && pieces[row][col]->getType() == Piece_T::PAWN){
-                    Pawn* pawn = dynamic_cast<Pawn*>(pieces[row][col].get());
-                    if(pawn->getEnPassantCaptureStatus()){
-                        pawn->setEnPassantCaptureStatus(false);
-                    }
-                }
-            }
-        }
-        setCheckToResetEnPassant(false);
+// Core move execution. Assumes the move is legal in the current position.
+void Board::makeMove(Move move) {
+    if(m_state.sideToMove == Color_T::WHITE) {
+        _makeMove<Color_T::WHITE>(move);
+    } else {
+        _makeMove<Color_T::BLACK>(move);
     }
+}
 
-    // Piece dependent updates, pawn is complicated, however rook and king cases update hasMoved var; used to determine if king can castle.
-    switch(pieces[toRow][toCol]->getType()){
-        case Piece_T::PAWN: {
-            Pawn* pawn = dynamic_cast<Pawn*>(pieces[toRow][toCol].get());
-            if(pawn->getEnPassantCaptureStatus()){
-                pawn->setEnPassantCaptureStatus(false);
-            } else {
-                if(pawn->getColor() == Color_T::BLACK && toRow == 3 && pawn->getHasMoved() == false){ // If we just moved 2 as black.
-                    pawn->setEnPassantCaptureStatus(true);
-                    setCheckToResetEnPassant(true);
-                } else if (pawn->getColor() == Color_T::WHITE && toRow == 4 && pawn->getHasMoved() == false){ // If we just moved 2 as white.
-                    pawn->setEnPassantCaptureStatus(true);
-                    setCheckToResetEnPassant(true);
-                }
-            }
-            pawn->setHasMoved(true);
-            // Handle pawn promotion with specified piece
-            if(pawnCanPromote(to, pieces[toRow][toCol]->getColor())){
-                Color_T pawnColor = pieces[toRow][toCol]->getColor();
-
-                pieces[toRow][toCol].reset(); // Free the pawn
-                to.setOccupied(false); // Reset square occupied status
-                switch(promotionPiece){
-                    case Piece_T::QUEEN:
-                        pieces[toRow][toCol] = std::make_unique<Queen>(Piece_T::QUEEN, pawnColor, to, *this);
-                        break;
-                    case Piece_T::ROOK:
-                        pieces[toRow][toCol] = std::make_unique<Rook>(Piece_T::ROOK, pawnColor, to, *this);
-                        break;
-                    case Piece_T::BISHOP:
-                        pieces[toRow][toCol] = std::make_unique<Bishop>(Piece_T::BISHOP, pawnColor, to, *this);
-                        break;
-                    case Piece_T::KNIGHT:
-                        pieces[toRow][toCol] = std::make_unique<Knight>(Piece_T::KNIGHT, pawnColor, to, *this);
-                        break;
-                    default:
-                        pieces[toRow][toCol] = std::make_unique<Queen>(Piece_T::QUEEN, pawnColor, to, *this);
-                }
-                to.setOccupied(true); // Set it back to occupied
-            }
-            break;
-        }
-        
-        case Piece_T::KING: {
-            King* king = dynamic_cast<King*>(pieces[toRow][toCol].get());
-
-            if(king->getHasMoved() == false){
-                king->setHasMoved(true);
-                king->setCanCastleLong(false);
-                king->setCanCastleShort(false);
-            }
+void Board::unmakeMove() {
+    // The side that made the last move is the one not to move now.
+    if(m_state.sideToMove == Color_T::WHITE) {
+        _unmakeMove<Color_T::BLACK>();
+    } else {
+        _unmakeMove<Color_T::WHITE>();
+    }
+}
 
-            if(king->getColor() == Color_T::BLACK) {
-                m_castleRights.blackLong = false;
-                m_castleRights.blackShort = false;
-            } else {
-                m_castleRights.whiteLong = false;
-                m_castleRights.whiteShort = false;
-            }
+template<Color_T Us>
+void Board::_makeMove(Move move) {
+    constexpr Color_T Them = oppositeColor(Us);
+    constexpr size_t HOME_ROW = (Us == Color_T::WHITE) ? MAX_ROWS - 1 : 0;
+    const size_t from = move.from();
+    const size_t to = move.to();
+    const bool isPawnMove = pieceCodeType(m_position.pieceOn(from)) == Piece_T::PAWN;
+
+    const PieceCode moving = m_position.pieceOn(from);
+
+    UndoRecord undo{move, m_position.pieceOn(to), m_state};
+    Bitboard changed = squareBB(from) | squareBB(to);
+
+    // Take out the old castling and en passant terms, the new ones go back in once the move is on the board.
+    m_state.key ^= Zobrist::castling(m_state.castling) ^ _enPassantKey<Us>();
+
+    if(move.isEnPassant()) {
+        // The captured pawn sits beside us, not on the landing square.
+        size_t capturedSq = makeSquare(squareRow(from), squareCol(to));
+        undo.captured = m_position.pieceOn(capturedSq);
+        m_position.removePiece(capturedSq);
+        m_state.key ^= Zobrist::piece(undo.captured, capturedSq);
+        changed |= squareBB(capturedSq);
+    } else if(undo.captured != NO_PIECE) {
+        m_position.removePiece(to);
+        m_state.key ^= Zobrist::piece(undo.captured, to);
+    }
+
+    m_position.movePiece(from, to);
+    m_state.key ^= Zobrist::piece(moving, from) ^ Zobrist::piece(moving, to);
+
+    if(move.isPromotion()) {
+        m_position.removePiece(to);
+        m_position.putPiece(to, Us, move.promotion());
+        m_state.key ^= Zobrist::piece(moving, to) ^ Zobrist::piece(makePieceCode(Us, move.promotion()), to);
+    } else if(move.isCastling()) {
+        bool isShort = squareCol(to) > squareCol(from);
+        size_t rookFrom = makeSquare(HOME_ROW, isShort ? MAX_COLS - 1 : 0);
+        size_t rookTo = makeSquare(HOME_ROW, isShort ? MAX_COLS - 3 : 3);
+        m_position.movePiece(rookFrom, rookTo);
+        constexpr PieceCode rook = makePieceCode(Us, Piece_T::ROOK);
+        m_state.key ^= Zobrist::piece(rook, rookFrom) ^ Zobrist::piece(rook, rookTo);
+        changed |= squareBB(rookFrom) | squareBB(rookTo);
+    }
+    m_attackMap.update(m_position, changed);
+
+    m_state.castling &= BoardState::CASTLING_KEPT[from] & BoardState::CASTLING_KEPT[to];
+
+    // A two step pawn move leaves the skipped square as the en passant target.
+    const bool isDoublePush = isPawnMove && (from > to ? from - to : to - from) == 2 * MAX_COLS;
+    m_state.epSquare = static_cast<std::uint8_t>(isDoublePush ? (from + to) / 2 : NO_SQUARE);
+
+    m_state.halfMoves = (isPawnMove || undo.captured != NO_PIECE) ? 0 : m_state.halfMoves + 1;
+    if constexpr(Us == Color_T::BLACK) {
+        ++m_state.fullMoves; // Only increment full move counter after Black's move
+    }
+    m_state.sideToMove = Them;
+
+    m_state.key ^= Zobrist::blackToMove() ^ Zobrist::castling(m_state.castling) ^ _enPassantKey<Them>();
+    assert(m_state.key == _computeKey());
+    m_facadeStale = true;
+
+    m_history.push_back(undo);
+}
 
-            break;
-        }
-        
-        case Piece_T::ROOK: {
-            Rook* rook = dynamic_cast<Rook*>(pieces[toRow][toCol].get());
-            _updateRookData(rook);
-            break;
-        }
+template<Color_T Us>
+void Board::_unmakeMove() {
+    constexpr size_t HOME_ROW = (Us == Color_T::WHITE) ? MAX_ROWS - 1 : 0;
+    const UndoRecord undo = m_history.back();
+    m_history.pop_back();
 
-        default:
-            break;
-    }
+    const Move move = undo.move;
+    const size_t from = move.from();
+    const size_t to = move.to();
+    Bitboard changed = squareBB(from) | squareBB(to);
 
-    for(size_t row = 0; row < MAX_ROWS; ++row){
-        for(size_t col = 0; col < MAX_COLS; ++col){
-            Piece* somePiece = pieces[row][col].get();
-            if(!somePiece){continue;}
-            somePiece->updateAttacking(); // Update the piece's attacking vector after changing position.
-        }
+    if(move.isPromotion()) {
+        m_position.removePiece(to);
+        m_position.putPiece(to, Us, Piece_T::PAWN);
+    } else if(move.isCastling()) {
+        bool isShort = squareCol(to) > squareCol(from);
+        size_t rookFrom = makeSquare(HOME_ROW, isShort ? MAX_COLS - 1 : 0);
+        size_t rookTo = makeSquare(HOME_ROW, isShort ? MAX_COLS - 3 : 3);
+        m_position.movePiece(rookTo, rookFrom);
+        changed |= squareBB(rookFrom) | squareBB(rookTo);
     }
 
-    Piece* p = pieces[toRow][toCol].get();
-    m_lastPieceMoved = p; // Update this.
-
-    // Only increment full move counter after Black's move
-    if(p->getColor() == Color_T::BLACK) {
-        ++m_totalMoves;
-    }
-    // Update the fen with new position.
-    _updateFen();
+    m_position.movePiece(to, from);
 
-    if(_checkCheckmate()) {
-        return Game_Status::CHECKMATE_END;
-    } else if (_checkDraw(p->getColor() == Color_T::WHITE ? Color_T::BLACK : Color_T::WHITE)){
-        return Game_Status::DRAW_END;
-    } else if (p->getColor() == Color_T::BLACK) {
-        if(_kingInCheck(getWhiteKing())){
-            _setWhiteKingInCheck(true);
-            return Game_Status::IN_CHECK;
-        }
-    } else if (p->getColor() == Color_T::WHITE){
-        if(_kingInCheck(getBlackKing())){
-            _setBlackKingInCheck(true);
-            return Game_Status::IN_CHECK;
-        }
+    if(undo.captured != NO_PIECE) {
+        size_t capturedSq = move.isEnPassant() ? makeSquare(squareRow(from), squareCol(to)) : to;
+        m_position.putPiece(capturedSq, pieceCodeColor(undo.captured), pieceCodeType(undo.captured));
+        changed |= squareBB(capturedSq);
     }
+    m_attackMap.update(m_position, changed);
 
-    _setBlackKingInCheck(false);
-    _setWhiteKingInCheck(false);
-
-    return Game_Status::CONTINUE;
+    m_state = undo.state;
+    assert(m_state.key == _computeKey());
+    m_facadeStale = true;
 }
 
-// Update the m_fen based on the new board states and positions.
-void Board::_updateFen() {
-    // Reconstruct FEN string from current DBoard state
-    std::string boardString = "";
-    
+// Writes the FEN for the current state into buffer, NUL terminated. Nothing is allocated, so this is
+// cheap enough to call whenever a FEN is actually needed instead of keeping one up to date.
+// Returns the length without the terminator, or 0 if bufferSize is too small.
+size_t Board::writeFen(char* buffer, size_t bufferSize) const {
+    static constexpr char PIECE_CHARS[NUM_PIECE_CODES]{'p', 'n', 'b', 'r', 'q', 'k', 'P', 'N', 'B', 'R', 'Q', 'K'};
+    char fen[FEN_BUFFER_SIZE];
+    char* out = fen;
+
     for(size_t row = 0; row < MAX_ROWS; ++row) {
-        size_t emptySquares = 0;
-        
+        char emptySquares = 0;
         for(size_t col = 0; col < MAX_COLS; ++col) {
-            const Piece* piece = pieces[row][col].get();
-            
-            if(!piece) {
+            PieceCode piece = m_position.pieceOn(makeSquare(row, col));
+            if(piece == NO_PIECE) {
                 ++emptySquares;
-            } else {
-                // Add any accumulated empty squares
-                if(emptySquares > 0) {
-                    boardString += std::to_string(emptySquares);
-                    emptySquares = 0;
-                }
-                
-                // Add piece character
-                switch(piece->getColor()) {
-                    case Color_T::BLACK:
-                        switch(piece->getType()){
-                            case Piece_T::PAWN:   boardString += 'p'; break;
-                            case Piece_T::ROOK:   boardString += 'r'; break;
-                            case Piece_T::KNIGHT: boardString += 'n'; break;
-                            case Piece_T::BISHOP: boardString += 'b'; break;
-                            case Piece_T::QUEEN:  boardString += 'q'; break;
-                            case Piece_T::KING:   boardString += 'k'; break;
-                        }
-                        break;
-                    case Color_T::WHITE:
-                        switch(piece->getType()){
-                            case Piece_T::PAWN:   boardString += 'P'; break;
-                            case Piece_T::ROOK:   boardString += 'R'; break;
-                            case Piece_T::KNIGHT: boardString += 'N'; break;
-                            case Piece_T::BISHOP: boardString += 'B'; break;
-                            case Piece_T::QUEEN:  boardString += 'Q'; break;
-                            case Piece_T::KING:   boardString += 'K'; break;
-                        }
-                        break;
-                }
+                continue;
+            }
+            if(emptySquares > 0) {
+                *out++ = static_cast<char>('0' + emptySquares);
+                emptySquares = 0;
             }
+            *out++ = PIECE_CHARS[piece];
         }
-        
         if(emptySquares > 0) {
-            boardString += std::to_string(emptySquares);
+            *out++ = static_cast<char>('0' + emptySquares);
         }
-        
         if(row < MAX_ROWS - 1) {
-            boardString += '/';
+            *out++ = '/';
         }
     }
-    
-    char activeColor{'w'};
-    if(m_lastPieceMoved){
-        activeColor = (m_lastPieceMoved->getColor() == Color_T::WHITE) ? 'b' : 'w';
-    } else {
-        // If no piece has been moved yet, use the active turn from the current FEN
-        activeColor = m_fen.getActiveTurn();
-    }
-    
-    
-    std::string castlingRights;
-    if(m_whiteKing->getCanCastleShort() && m_castleRights.whiteShort){castlingRights += 'K';}
-    if(m_whiteKing->getCanCastleLong() && m_castleRights.whiteLong){castlingRights += 'Q';}
-    if(m_blackKing->getCanCastleShort() && m_castleRights.blackShort){ castlingRights += 'k';}
-    if(m_blackKing->getCanCastleLong() && m_castleRights.blackLong){castlingRights += 'q';}
 
-    if(castlingRights.length() == 0){castlingRights = "-";}
+    *out++ = ' ';
+    *out++ = m_state.sideToMove == Color_T::WHITE ? 'w' : 'b';
+
+    *out++ = ' ';
+    char* castleStart = out;
+    if(m_state.castling & BoardState::WHITE_SHORT) { *out++ = 'K'; }
+    if(m_state.castling & BoardState::WHITE_LONG) { *out++ = 'Q'; }
+    if(m_state.castling & BoardState::BLACK_SHORT) { *out++ = 'k'; }
+    if(m_state.castling & BoardState::BLACK_LONG) { *out++ = 'q'; }
+    if(out == castleStart) { *out++ = '-'; }
 
-    std::string enPassantTarget;
-    if(!m_checkToResetEnPassant){
-        enPassantTarget = "-";
+    *out++ = ' ';
+    if(m_state.epSquare != NO_SQUARE) {
+        *out++ = static_cast<char>('a' + squareCol(m_state.epSquare));
+        *out++ = static_cast<char>('8' - squareRow(m_state.epSquare));
     } else {
-        size_t targetPawnFenRow{0};
-        size_t targetPawnFenCol{0};
-        if(m_lastPieceMoved){
-            const Square& squareOfPawn = m_lastPieceMoved->getSquarePosition();
-            if(m_lastPieceMoved->getColor() == Color_T::WHITE){
-                targetPawnFenRow = squareOfPawn.getRow() + 1;
-                targetPawnFenCol = squareOfPawn.getCol();
+        *out++ = '-';
+    }
 
-            } else {
-                targetPawnFenRow = squareOfPawn.getRow() - 1;
-                targetPawnFenCol = squareOfPawn.getCol();
-            }
-        }
-        enPassantTarget = coordsToNotation(targetPawnFenRow, targetPawnFenCol);
+    // The clocks are uint16_t, at most 5 digits each, so the longest FEN is 93 characters and always
+    // fits FEN_BUFFER_SIZE. The checks only keep the compiler happy.
+    char* const fenEnd = fen + FEN_BUFFER_SIZE - 1;
+    *out++ = ' ';
+    out = std::to_chars(out, fenEnd, m_state.halfMoves).ptr;
+    if(out == fenEnd) {
+        return 0;
     }
-    
-    std::string halfmoveClock = std::to_string(m_totalHalfMoves);
-    
-    std::string fullmoveNumber = std::to_string(m_totalMoves);
-    
-    // Construct complete FEN string
-    std::string newFENString = boardString + " " + activeColor + " " + 
-                              castlingRights + " " + enPassantTarget + " " + 
-                              halfmoveClock + " " + fullmoveNumber;
-    
-    // Update current FEN
-    m_fen = FENString{newFENString};
+    *out++ = ' ';
+    out = std::to_chars(out, fenEnd, m_state.fullMoves).ptr;
+
+    size_t length = static_cast<size_t>(out - fen);
+    if(length + 1 > bufferSize) {
+        return 0;
+    }
+    std::memcpy(buffer, fen, length);
+    buffer[length] = '\0';
+    return length;
 }
 
 std::string Board::getFenStr() const {
-    return m_fen.getFen();
+    char fen[FEN_BUFFER_SIZE];
+    size_t length = writeFen(fen, sizeof(fen));
+    return std::string{fen, length};
 }
 
 // e.g. row = 7, col = 7; notation = "H1"
@@ -1143,117 +986,62 @@ std::string Board::coordsToNotation(size_t& row, size_t& col) const {
     return notation;
 }
 
-void Board::_setBlackKingInCheck(bool newVal) {m_blackKingInCheck = newVal;}
-void Board::_setWhiteKingInCheck(bool newVal) {m_whiteKingInCheck = newVal;}
-
-bool Board::getBlackKingInCheck() const {return m_blackKingInCheck;}
-bool Board::getWhiteKingInCheck() const {return m_whiteKingInCheck;}
+bool Board::isDraw(unsigned int occurrences) const {
+    static constexpr std::uint16_t FIFTY_MOVE_PLIES{100};
+    return m_state.halfMoves >= FIFTY_MOVE_PLIES || isInsufficientMaterial() || _repetitions() + 1 >= occurrences;
+}
 
-// Can the king be captured by a piece if this move were to occur?
-bool Board::_kingInCheck(const Piece* king) const {
-    for(size_t row = 0; row < MAX_ROWS; ++row){
-        for(size_t col = 0; col < MAX_COLS; ++col){
-            const Piece* p = pieces[row][col].get();
-            if(!p){continue;}
-            const std::vector<const Piece*>& attacking = p->getAttacking();
-            if(std::find(attacking.begin(), attacking.end(), king) != attacking.end()){ // Found a piece attacking the king.
-                return true;
-            }
-        }
+// Material (kings left out) that cannot mate whatever either side does: bare kings, a lone knight,
+// or bishops only, all standing on squares of one color.
+bool Board::isInsufficientMaterial() const {
+    using Material = Position::Material;
+    static constexpr Material KING_FIELDS = 0xFULL * (Position::materialOf(makePieceCode(Color_T::WHITE, Piece_T::KING))
+                                                    | Position::materialOf(makePieceCode(Color_T::BLACK, Piece_T::KING)));
+    static constexpr Material BISHOP_FIELDS = 0xFULL * (Position::materialOf(makePieceCode(Color_T::WHITE, Piece_T::BISHOP))
+                                                      | Position::materialOf(makePieceCode(Color_T::BLACK, Piece_T::BISHOP)));
+    static constexpr std::array<Material, 3> DEAD_MATERIAL{
+        0,
+        Position::materialOf(makePieceCode(Color_T::WHITE, Piece_T::KNIGHT)),
+        Position::materialOf(makePieceCode(Color_T::BLACK, Piece_T::KNIGHT)),
+    };
+    static constexpr Bitboard LIGHT_SQUARES_BB{0xAA55AA55AA55AA55ULL};
+
+    const Material material = m_position.material() & ~KING_FIELDS;
+    if(std::find(DEAD_MATERIAL.begin(), DEAD_MATERIAL.end(), material) != DEAD_MATERIAL.end()) {
+        return true;
     }
-    return false;
+    if(material & ~BISHOP_FIELDS) {
+        return false;
+    }
+    const Bitboard bishops = m_position.pieces(Piece_T::BISHOP);
+    return (bishops & LIGHT_SQUARES_BB) == EMPTY_BB || (bishops & ~LIGHT_SQUARES_BB) == EMPTY_BB;
 }
 
-bool Board::_kingInCheck(const Piece* king, const std::array<std::array<std::unique_ptr<Piece>, MAX_COLS>, MAX_ROWS>& piecesCopy) const {
-    for(size_t row = 0; row < MAX_ROWS; ++row){
-        for(size_t col = 0; col < MAX_COLS; ++col){
-            const Piece* p = piecesCopy[row][col].get();
-            if(!p){continue;}
-            const std::vector<const Piece*>& attacking = p->getAttacking();
-            if(std::find(attacking.begin(), attacking.end(), king) != attacking.end()){ // Found a piece attacking the king.
-                return true;
-            }
+// Only positions since the last capture or pawn move can repeat, and only every other ply has the
+// same side to move, so the scan is bounded by the halfmove clock. The nearest candidate is 4 plies back.
+unsigned int Board::_repetitions() const {
+    const size_t reach = std::min<size_t>(m_state.halfMoves, m_history.size());
+    unsigned int count{0};
+    for(size_t back = 4; back <= reach; back += 2) {
+        if(m_history[m_history.size() - back].state.key == m_state.key) {
+            ++count;
         }
     }
-    return false;
+    return count;
 }
 
-bool Board::_checkCheckmate() const {
-    // Check if either king is in check
-    bool whiteInCheck = _kingInCheck(m_whiteKing);
-    bool blackInCheck = _kingInCheck(m_blackKing);
-    
-    // If no king is in check, it's not checkmate
-    if(!whiteInCheck && !blackInCheck) return false;
-    
-    Color_T checkedColor = whiteInCheck ? Color_T::WHITE : Color_T::BLACK;
-    
-    // Try all possible moves for the checked player
-    for(size_t fromRow = 0; fromRow < MAX_ROWS; ++fromRow) {
-        for(size_t fromCol = 0; fromCol < MAX_COLS; ++fromCol) {
-            const Piece* piece = getPieceAt(fromRow, fromCol);
-            if(!piece || piece->getColor() != checkedColor) continue;
-            
-            // Try moving this piece to every square
-            for(size_t toRow = 0; toRow < MAX_ROWS; ++toRow) {
-                for(size_t toCol = 0; toCol < MAX_COLS; ++toCol) {
-                    Square from = getBoardAt(fromRow, fromCol);
-                    Square to = getBoardAt(toRow, toCol);
-                    
-                    // Skip invalid basic moves
-                    if(!piece->isValidMove(to)) continue;
-                    
-                    // Check if this move would get out of check
-                    if(!_wouldLeaveKingInCheck(from, to, checkedColor)) {
-                        return false; // Found a legal move - not checkmate
-                    }
-                }
-            }
-        }
-    }
-    
-    return true; // No legal moves found - checkmate!
+bool Board::getBlackKingInCheck() const {return _kingInCheck(Color_T::BLACK);}
+bool Board::getWhiteKingInCheck() const {return _kingInCheck(Color_T::WHITE);}
+
+Bitboard Board::checkers() const {
+    const size_t kingSq = m_position.kingSquare(m_state.sideToMove);
+    if(kingSq == NO_SQUARE) { return EMPTY_BB; }
+    return m_position.attackersTo(kingSq, m_position.occupied()) & m_position.pieces(oppositeColor(m_state.sideToMove));
 }
-bool Board::_checkDraw(Color_T currentPlayerColor) const {
-    // Check if current player's king is in check
-    const King* currentKing = (currentPlayerColor == Color_T::WHITE) ? m_whiteKing : m_blackKing;
-    bool currentPlayerInCheck = _kingInCheck(currentKing);
-    
-    // Stalemate: King NOT in check but no legal moves
-    if(!currentPlayerInCheck) {
-        // Try all possible moves for the current player
-        for(size_t fromRow = 0; fromRow < MAX_ROWS; ++fromRow) {
-            for(size_t fromCol = 0; fromCol < MAX_COLS; ++fromCol) {
-                const Piece* piece = getPieceAt(fromRow, fromCol);
-                if(!piece || piece->getColor() != currentPlayerColor) continue;
-                
-                // Try moving this piece to every square
-                for(size_t toRow = 0; toRow < MAX_ROWS; ++toRow) {
-                    for(size_t toCol = 0; toCol < MAX_COLS; ++toCol) {
-                        Square from = getBoardAt(fromRow, fromCol);
-                        Square to = getBoardAt(toRow, toCol);
-                        
-                        // Skip invalid basic moves
-                        if(!piece->isValidMove(to)) continue;
-                        
-                        // Check if this move is legal (doesn't leave king in check)
-                        if(!_wouldLeaveKingInCheck(from, to, currentPlayerColor)) {
-                            return false; // Found a legal move - not stalemate
-                        }
-                    }
-                }
-            }
-        }
-        
-        return true; // No legal moves found and not in check - stalemate!
-    }
-    
-    // TODO: Add other draw conditions:
-    // - Insufficient material (K vs K, K+B vs K, K+N vs K, etc.)
-    // - 50-move rule
-    // - Threefold repetition
-    
-    return false; // Not a draw
+
+// Is the king's square attacked by any enemy piece?
+bool Board::_kingInCheck(Color_T color) const {
+    return (m_attackMap.attacks(oppositeColor(color)) & m_position.pieces(color, Piece_T::KING)) != EMPTY_BB;
 }
 
 Piece_T Board::_promptForPromotion() const {
@@ -1303,26 +1091,19 @@ bool Board::validPawnMove(const Square& from, const Square& to, Color_T pawnColo
 
     if(!_prelimMoveCheck(moveData)){ return false; }
 
+    bool toSquareOccupied = !m_position.isEmpty(makeSquare(moveData.toRow, moveData.toCol));
+
     if(_isTwoStepMove(pawnColor, moveData)){
-        return _isValidTwoStepMove(pawnColor, moveData, to.isOccupied(), hasMoved);
+        return _isValidTwoStepMove(pawnColor, moveData, toSquareOccupied, hasMoved);
     }
 
     if(_isOneStepMove(pawnColor, moveData)){
-        return _isValidOneStepMove(pawnColor, moveData, to.isOccupied());
+        return _isValidOneStepMove(pawnColor, moveData, toSquareOccupied);
     }
 
-    if(_isAttackRightMove(pawnColor, moveData)){
-        if(_isValidEnPassant(pawnColor, moveData, to.isOccupied())){
-            return true;
-        } else if (_isValidAttackMove(pawnColor, moveData, to.isOccupied())) {
-            return true;
-        }
-    } else if (_isAttackLeftMove(pawnColor, moveData)){
-        if(_isValidEnPassant(pawnColor, moveData, to.isOccupied())){
-            return true;
-        } else if (_isValidAttackMove(pawnColor, moveData, to.isOccupied())) {
-            return true;
-        }
+    // Diagonal captures, one lookup in the pawn attack table.
+    if(Attacks::pawn(pawnColor, makeSquare(moveData.fromRow, moveData.fromCol)) & squareBB(makeSquare(moveData.toRow, moveData.toCol))){
+        return _isValidEnPassant(pawnColor, moveData, toSquareOccupied) || _isValidAttackMove(pawnColor, moveData, toSquareOccupied);
     }
     return false;
 }
@@ -1332,18 +1113,13 @@ bool Board::validBishopMove(const Square& from, const Square& to, Color_T bishop
 
     if (!_prelimMoveCheck(moveData)) { return false; } // Check bounds and if moving to same spot.
 
-    int deltaRow = static_cast<int>(moveData.toRow) - static_cast<int>(moveData.fromRow);
-    int deltaCol = static_cast<int>(moveData.toCol) - static_cast<int>(moveData.fromCol);
+    Bitboard target = squareBB(makeSquare(moveData.toRow, moveData.toCol));
 
-    if(abs(deltaRow) != abs(deltaCol)){ return false; } // Not on diagonal
+    // Off the diagonals or something was in between.
+    if(!(Attacks::bishop(makeSquare(moveData.fromRow, moveData.fromCol), m_position.occupied()) & target)){ return false; }
 
-    const Piece* p = getPieceAt(moveData.toRow, moveData.toCol);
-    if(p){
-        if(p->getColor() == bishopColor){ return false; } // Cant take a friendly piece.
-    }
+    if(m_position.pieces(bishopColor) & target){ return false; } // Cant take a friendly piece.
 
-    if(_checkDiagBlocked(moveData, deltaRow, deltaCol)){ return false; } // Something was in between.
-     
     return true;
 }
 
@@ -1352,30 +1128,13 @@ bool Board::validKnightMove(const Square& from, const Square& to, Color_T knight
 
     if (!_prelimMoveCheck(moveData)) { return false; } // Check bounds and if moving to same spot.
 
-    switch(from.getSquareColor()){
-        case Color_T::BLACK:
-            if(to.getSquareColor() != Color_T::WHITE) { return false; }
-            break;
-        case Color_T::WHITE:
-            if(to.getSquareColor() != Color_T::BLACK) { return false; }
-            break;
-    }
-
-    int deltaRow = static_cast<int>(moveData.toRow) - static_cast<int>(moveData.fromRow);
-    int deltaCol = static_cast<int>(moveData.toCol) - static_cast<int>(moveData.fromCol); 
+    Bitboard target = squareBB(makeSquare(moveData.toRow, moveData.toCol));
 
-    if((abs(deltaCol) == 2 && abs(deltaRow) == 1)
-    || (abs(deltaCol) == 1 && abs(deltaRow) == 2)){
-        const Piece* p = getPieceAt(moveData.toRow, moveData.toCol);
+    if(!(Attacks::knight(makeSquare(moveData.fromRow, moveData.fromCol)) & target)){ return false; } // Not an L shape.
 
-        if(p){
-            if(p->getColor() == knightColor){ return false; } // Cant take a friendly piece.
-        }
-
-        return true;
-    }
+    if(m_position.pieces(knightColor) & target){ return false; } // Cant take a friendly piece.
 
-    return false;
+    return true;
 }
 
 bool Board::validRookMove(const Square& from, const Square& to, Color_T rookColor) const {
@@ -1383,18 +1142,13 @@ bool Board::validRookMove(const Square& from, const Square& to, Color_T rookColo
 
     if (!_prelimMoveCheck(moveData)) { return false; } // Check bounds and if moving to same spot.
 
-    int deltaRow = static_cast<int>(moveData.toRow) - static_cast<int>(moveData.fromRow);
-    int deltaCol = static_cast<int>(moveData.toCol) - static_cast<int>(moveData.fromCol);
+    Bitboard target = squareBB(makeSquare(moveData.toRow, moveData.toCol));
 
-    if(!((moveData.fromCol == moveData.toCol) || (moveData.fromRow == moveData.toRow))){ return false; } // Not on rank or file
+    // Not on rank or file, or something was in between.
+    if(!(Attacks::rook(makeSquare(moveData.fromRow, moveData.fromCol), m_position.occupied()) & target)){ return false; }
 
-    const Piece* p = getPieceAt(moveData.toRow, moveData.toCol);
-    if(p){
-        if(p->getColor() == rookColor){ return false; } // Cant take a friendly piece.
-    }
+    if(m_position.pieces(rookColor) & target){ return false; } // Cant take a friendly piece.
 
-    if(_checkRankFileBlocked(moveData, deltaRow, deltaCol)){ return false; } // Something was in between.
-     
     return true;
 }
 
@@ -1403,27 +1157,13 @@ bool Board::validQueenMove(const Square& from, const Square& to, Color_T queenCo
 
     if (!_prelimMoveCheck(moveData)) { return false; } // Check bounds and if moving to same spot.
 
-    int deltaRow = static_cast<int>(moveData.toRow) - static_cast<int>(moveData.fromRow);
-    int deltaCol = static_cast<int>(moveData.toCol) - static_cast<int>(moveData.fromCol);
+    Bitboard target = squareBB(makeSquare(moveData.toRow, moveData.toCol));
 
-    if(!((moveData.fromCol == moveData.toCol) 
-        || (moveData.fromRow == moveData.toRow)
-        || (abs(deltaRow) == abs(deltaCol))))
-        { return false; } // Not on rank or file
+    // Not on rank, file or diagonal, or something was in between.
+    if(!(Attacks::queen(makeSquare(moveData.fromRow, moveData.fromCol), m_position.occupied()) & target)){ return false; }
+
+    if(m_position.pieces(queenColor) & target){ return false; } // Cant take a friendly piece.
 
-    const Piece* p = getPieceAt(moveData.toRow, moveData.toCol);
-    if(p){
-        if(p->getColor() == queenColor){ return false; } // Cant take a friendly piece.
-    }
-    if(deltaRow == 0 || deltaCol == 0){
-        if(_checkRankFileBlocked(moveData, deltaRow, deltaCol)){
-            return false;
-        }
-    } else {
-        if(_checkDiagBlocked(moveData, deltaRow, deltaCol)){ 
-            return false; // Something was in between.
-        } 
-    }
     return true;
 }
 
@@ -1432,204 +1172,37 @@ bool Board::validKingMove(const Square& from, const Square& to, Color_T kingColo
 
     if (!_prelimMoveCheck(moveData)) { return false; } // Check bounds and if moving to same spot.
 
-    int deltaRow = static_cast<int>(moveData.toRow) - static_cast<int>(moveData.fromRow);
-    int deltaCol = static_cast<int>(moveData.toCol) - static_cast<int>(moveData.fromCol);
+    Bitboard target = squareBB(makeSquare(moveData.toRow, moveData.toCol));
 
     // Add castle rights, long and short, O-O or O-O-O.
-    if(!(abs(deltaRow) <= 1 && abs(deltaCol) <= 1)) { // King can only move 1 square in any direction
+    if(!(Attacks::king(makeSquare(moveData.fromRow, moveData.fromCol)) & target)) { // King can only move 1 square in any direction
         if(!_isValidCastleMove(moveData, kingColor)){ // or castle
             return false; 
         }
     } 
 
-    const Piece* p = getPieceAt(moveData.toRow, moveData.toCol);
-    if(p){
-        if(p->getColor() == kingColor){ return false; } // Cant take a friendly piece.
-    }
+    if(m_position.pieces(kingColor) & target){ return false; } // Cant take a friendly piece.
 
     return true;
 }
 
-// Nasty function, refactor in a not so terrible way soon.
+// Castling is the king moving two squares from its home square towards one of its rooks.
 bool Board::_isValidCastleMove(const MoveCoordsData& moveData, Color_T kingColor) const{
-    const King* king = (kingColor == Color_T::WHITE)? getWhiteKing() : getBlackKing();
-
-    // Cannot castle when king is in check
-    if(_kingInCheck(king)){
+    const size_t homeRow = (kingColor == Color_T::WHITE) ? MAX_ROWS - 1 : 0;
+    if(moveData.fromRow != homeRow || moveData.fromCol != 4 || moveData.toRow != homeRow) {
         return false;
     }
 
-    if(king->getHasMoved() == false){ // If the king hasnt moved.
-
-        const Piece* pieceLandingOn = getPieceAt(moveData.toRow, moveData.toCol);
-        if(pieceLandingOn){ // King actually cant capture an enemy piece via castle.
-            return false;
-        }
-
-        // Helper function to check if king would be in check at a specific square
-        auto wouldKingBeInCheckAt = [this, &moveData, kingColor](size_t row, size_t col) -> bool {
-            Square from = getBoardAt(moveData.fromRow, moveData.fromCol);
-            Square to = getBoardAt(row, col);
-            return _wouldLeaveKingInCheck(from, to, kingColor);
-        };
-
-        switch(kingColor){
-            case Color_T::BLACK: {
-                if(moveData.toCol == MAX_COLS - 2 && moveData.toRow == 0){ // Black castling short
-                    if(!king->getCanCastleShort()){
-                        return false;
-                    }
-                    const Piece* p = getPieceAt(0, MAX_COLS - 1); // Possible rook?
-                    if(p){ // If there is a piece
-                        if(p->getType() == Piece_T::ROOK){ // If that piece is a rook
-                            const Rook* rook = dynamic_cast<const Rook*>(p); // Safely cast to a Rook*
-                            if(rook->getHasMoved() == false){ // Determine if it has moved.
-                                if(!_checkRankFileBlocked(moveData, 0, 1)){ // If no pieces in the way.
-                                    // Check if king passes through check (squares f8, g8)
-                                    if(wouldKingBeInCheckAt(0, 5) || wouldKingBeInCheckAt(0, 6)) {
-                                        return false; // King would pass through or end in check
-                                    }
-                                    return true;
-                                }
-                            }
-                        }
-                    }
-                } else if (moveData.toCol == 2 && moveData.toRow == 0){ // Black castling long
-                    const MoveCoordsData boundCheckingLong{moveData.fromRow, moveData.fromCol, moveData.toRow, moveData.toCol - 2};
-                    if(!king->getCanCastleLong()){
-                        return false;
-                    }
-                    const Piece* p = getPieceAt(0, 0); // Possible rook?
-                    if(p){ // If there is a piece
-                        if(p->getType() == Piece_T::ROOK){ // If that piece is a rook
-                            const Rook* rook = dynamic_cast<const Rook*>(p); // Safely cast to a Rook*
-                            if(rook->getHasMoved() == false){ // Determine if it has moved.
-                                if(!_checkRankFileBlocked(boundCheckingLong, 0, -1)){ // If no pieces in the way.
-                                    // Check if king passes through check (squares d8, c8)
-                                    if(wouldKingBeInCheckAt(0, 3) || wouldKingBeInCheckAt(0, 2)) {
-                                        return false; // King would pass through or end in check
-                                    }
-                                    return true;
-                                }
-                            }
-                        }
-                    }
-                }
-                return false;
-            }
-
-            case Color_T::WHITE: {
-                if(moveData.toCol == MAX_COLS - 2 && moveData.toRow == MAX_ROWS - 1){ // White castling short
-                    const Piece* p = getPieceAt(MAX_ROWS - 1, MAX_COLS - 1); // Possible rook?
-                    if(!king->getCanCastleShort()){
-                        return false;
-                    }
-                    if(p){ // If there is a piece
-                        if(p->getType() == Piece_T::ROOK){ // If that piece is a rook
-                            const Rook* rook = dynamic_cast<const Rook*>(p); // Safely cast to a Rook*
-                            if(rook->getHasMoved() == false){ // Determine if it has moved.
-                                if(!_checkRankFileBlocked(moveData, 0, 1)){ // If no pieces in the way.
-                                    // Check if king passes through check (squares f1, g1)
-                                    if(wouldKingBeInCheckAt(7, 5) || wouldKingBeInCheckAt(7, 6)) {
-                                        return false; // King would pass through or end in check
-                                    }
-                                    return true;
-                                }
-                            }
-                        }
-                    }
-                } else if (moveData.toCol == 2 && moveData.toRow == MAX_ROWS - 1){ // White castling long
-                    const MoveCoordsData boundCheckingLong{moveData.fromRow, moveData.fromCol, moveData.toRow, moveData.toCol - 2};
-                    const Piece* p = getPieceAt(MAX_ROWS - 1, 0); // Possible rook?
-                    if(!king->getCanCastleLong()){
-                        return false;
-                    }
-                    if(p){ // If there is a piece
-                        if(p->getType() == Piece_T::ROOK){ // If that piece is a rook
-                            const Rook* rook = dynamic_cast<const Rook*>(p); // Safely cast to a Rook*
-                            if(rook->getHasMoved() == false){ // Determine if it has moved.
-                                if(!_checkRankFileBlocked(boundCheckingLong, 0, -1)){ // If no pieces in the way.
-                                    // Check if king passes through check (squares d1, c1)
-                                    if(wouldKingBeInCheckAt(7, 3) || wouldKingBeInCheckAt(7, 2)) {
-                                        return false; // King would pass through or end in check
-                                    }
-                                    return true;
-                                }
-                            }
-                        }
-                    }
-                }
-                return false;
-            }
-        }
-    }
-    return false;
-}
-
-bool Board::_checkRankFileBlocked(const MoveCoordsData& moveData, int deltaRow, int deltaCol) const {
-    int rankDir{0};
-    int fileDir{0};
-    if(deltaRow == 0){
-        if(deltaCol > 0){
-            ++fileDir; // Right
-        } else {
-            --fileDir; // Left
-        }
-    } else {
-        if(deltaRow > 0){
-            ++rankDir; // Down
-        } else {
-            --rankDir; // Up
-        }
-    }
-    
-    int row = static_cast<int>(moveData.fromRow) + rankDir;
-    int col = static_cast<int>(moveData.fromCol) + fileDir;
-    int toRow = static_cast<int>(moveData.toRow);
-    int toCol = static_cast<int>(moveData.toCol);
-    
-    // Check path until we reach destination (exclusive)
-    if(deltaRow == 0){
-        while (col != toCol) {
-            const Piece* p = getPieceAt(static_cast<size_t>(row), static_cast<size_t>(col));
-            if (p) {
-                return true; // Path is blocked
-            }
-            col += fileDir;
-        }
-    } else {
-        while (row != toRow) {
-            const Piece* p = getPieceAt(static_cast<size_t>(row), static_cast<size_t>(col));
-            if (p) {
-                return true; // Path is blocked
-            }
-            row += rankDir;
-        }
+    bool isShort = (moveData.toCol == MAX_COLS - 2);
+    bool isLong = (moveData.toCol == 2);
+    if(!isShort && !isLong) {
+        return false;
     }
-    return false; // Path is clear
-}
 
-bool Board::_checkDiagBlocked(const MoveCoordsData& moveData, int deltaRow, int deltaCol) const {
-    // Determine direction
-    int rowStep = (deltaRow > 0) ? 1 : -1;
-    int colStep = (deltaCol > 0) ? 1 : -1;
-    
-    int row = static_cast<int>(moveData.fromRow) + rowStep;
-    int col = static_cast<int>(moveData.fromCol) + colStep;
-    int toRow = static_cast<int>(moveData.toRow);
-    int toCol = static_cast<int>(moveData.toCol);
-    
-    // Check path until we reach destination (exclusive)
-    while (row != toRow && col != toCol) {
-        const Piece* p = getPieceAt(static_cast<size_t>(row), static_cast<size_t>(col));
-        if (p) {
-            return true; // Path is blocked
-        }
-        row += rowStep;
-        col += colStep;
+    if(kingColor == Color_T::WHITE) {
+        return isShort ? _canCastle<Color_T::WHITE, true>() : _canCastle<Color_T::WHITE, false>();
     }
-    
-    return false; // Path is clear
+    return isShort ? _canCastle<Color_T::BLACK, true>() : _canCastle<Color_T::BLACK, false>();
 }
 
 bool Board::_prelimMoveCheck(const MoveCoordsData& moveData) const {
@@ -1672,12 +1245,10 @@ bool Board::_isValidTwoStepMove(Color_T pawnColor, const MoveCoordsData& moveDat
             // Check bounds of to square and get middle square (0-7 indexing)
             if(moveData.toRow > 7 || moveData.toCol != moveData.fromCol) return false;
 
-            const Piece* midPiece = getPieceAt(moveData.fromRow + 1, moveData.fromCol);
-            bool midSquareOccupied = (midPiece != nullptr);
+            bool midSquareOccupied = !m_position.isEmpty(makeSquare(moveData.fromRow + 1, moveData.fromCol));
 
             
             if(!toSquareOccupied && !midSquareOccupied){ // The two spaces are free to move in.
-                // Need to still implement a function to determine if it would put the king in check.
                 return true; 
             }
         
@@ -1687,8 +1258,7 @@ bool Board::_isValidTwoStepMove(Color_T pawnColor, const MoveCoordsData& moveDat
         case Color_T::WHITE: {
             // Check bounds for to square and get middle square (0-7 indexing)
             if(moveData.toRow > 4 || moveData.toCol != moveData.fromCol) { return false; }
-            const Piece* midPiece = getPieceAt(moveData.fromRow - 1, moveData.fromCol);
-            bool midSquareOccupied = (midPiece != nullptr);
+            bool midSquareOccupied = !m_position.isEmpty(makeSquare(moveData.fromRow - 1, moveData.fromCol));
 
             
             if(!toSquareOccupied && !midSquareOccupied){ // The two spaces are free to move in.
@@ -1698,6 +1268,7 @@ bool Board::_isValidTwoStepMove(Color_T pawnColor, const MoveCoordsData& moveDat
             return false;
         }
     }
+    return false;
 }
 
 // Confirm that we are moving 2 rows up or down (black or white) and we remain in same col.
@@ -1747,122 +1318,34 @@ bool Board::_isOneStepMove(Color_T pawnColor, const MoveCoordsData& moveData) co
 // Attack moves
 bool Board::_isValidAttackMove(Color_T pawnColor, const MoveCoordsData& moveData, bool toSquareOccupied) const{
 
-    switch(pawnColor){
-        case Color_T::BLACK: {
-            if(moveData.toRow >= MAX_ROWS || moveData.toCol >= MAX_COLS) return false;
-            
-            if(!toSquareOccupied){ 
-                return false; 
-            }
-
-            const Piece* toPiece = getPieceAt(moveData.toRow, moveData.toCol);
-            if(toPiece->getColor() == Color_T::BLACK){ // Friendly fire will not be tolerated :(.
-                return false;
-            }
-
-            return true;
-        }
-        
-        case Color_T::WHITE: {
-            // Check bounds for to square and get middle square (0-7 indexing)
-            if(moveData.toRow >= MAX_ROWS - 2 || moveData.toCol >= MAX_COLS ) { return false; }
-            
-            if(!toSquareOccupied){ 
-                // Need to still implement a function to determine if it would put the king in check.
-                return false; 
-            }
-
-            const Piece* toPiece = getPieceAt(moveData.toRow, moveData.toCol);
-            if(toPiece->getColor() == Color_T::WHITE){ // Friendly fire will not be tolerated :(.
-                return false;
-            }
-
-            return true;
-        }
-    }
-}
-
-bool Board::_isAttackRightMove(Color_T pawnColor, const MoveCoordsData& moveData) const{
+    if(moveData.toRow >= MAX_ROWS || moveData.toCol >= MAX_COLS) { return false; }
 
-    if(pawnColor == Color_T::BLACK) {
-        // Black pawns move down (increasing row)
-        return (moveData.toRow == (moveData.fromRow + 1)) && (moveData.toCol == moveData.fromCol - 1);  
-    } else {
-        // White pawns move up (decreasing row)
-        return (moveData.toRow == (moveData.fromRow - 1)) && (moveData.toCol == moveData.fromCol + 1);
+    if(!toSquareOccupied){ 
+        return false; 
     }
-}
 
-bool Board::_isAttackLeftMove(Color_T pawnColor, const MoveCoordsData& moveData) const {
-    if(pawnColor == Color_T::BLACK) {
-        // Black pawns move down (increasing row)
-        return (moveData.toRow == (moveData.fromRow + 1)) && (moveData.toCol == moveData.fromCol + 1);  
-    } else {
-        // White pawns move up (decreasing row)
-        return (moveData.toRow == (moveData.fromRow - 1)) && (moveData.toCol == moveData.fromCol - 1);
-    }
+    // Friendly fire will not be tolerated :(.
+    return (m_position.pieces(oppositeColor(pawnColor)) & squareBB(makeSquare(moveData.toRow, moveData.toCol))) != EMPTY_BB;
 }
 
 bool Board::_isValidEnPassant(Color_T pawnColor, const MoveCoordsData& moveData, bool toSquareOccupied) const {
-    // First check if there's a valid en passant target in the FEN
-    if(m_fen.getEnPassantTarget() == "-") {
-        return false; // No en passant possible if FEN shows no target
-    }
-    
-    // Verify the destination square matches the FEN en passant target
-    std::string enPassantTarget = m_fen.getEnPassantTarget();
-    size_t expectedRow = moveData.toRow;
-    size_t expectedCol = moveData.toCol;
-    std::string expectedSquare = coordsToNotation(expectedRow, expectedCol);
-    
-    if(enPassantTarget != expectedSquare) {
-        return false; // Move doesn't match the FEN en passant target
+    // The destination has to be the current en passant target.
+    if(m_state.epSquare == NO_SQUARE || makeSquare(moveData.toRow, moveData.toCol) != m_state.epSquare) {
+        return false;
     }
-    
-    switch(pawnColor){
-        case Color_T::BLACK: {
-            // Check bounds of to square (0-7 indexing)
-            if(moveData.toRow >= MAX_ROWS || moveData.toCol >= MAX_COLS) { return false; }
-            
-            // Impossible to en passant if a piece is on landing square.
-            if(toSquareOccupied){ 
-                return false; 
-            }
 
-            const Piece* p = getPieceAt(moveData.toRow - 1, moveData.toCol); // Piece to possibly capture.
+    if(moveData.toRow >= MAX_ROWS || moveData.toCol >= MAX_COLS) { return false; }
 
-            if(p){ // If p is a piece.
-                if(p->getType() == Piece_T::PAWN){ // If p is a pawn.
-                    const Pawn* pawnToCapture = dynamic_cast<const Pawn*>(p);
-                    if(pawnToCapture->getEnPassantCaptureStatus() && pawnToCapture->getColor() == Color_T::WHITE){
-                        return true;
-                    }
-                }
-            }
-
-            return false;
-        }
-        
-        case Color_T::WHITE: {
-            if(moveData.toRow >= MAX_ROWS|| moveData.toCol >= MAX_COLS) { return false; }
-            
-            // Impossible to en passant if a piece is on landing square.
-            if(toSquareOccupied){ return false; }
-
-            const Piece* p = getPieceAt(moveData.toRow + 1, moveData.toCol); // Piece to possibly capture.
+    // Impossible to en passant if a piece is on landing square.
+    if(toSquareOccupied){ 
+        return false; 
+    }
 
-            if(p){ // If p is a piece.
-                if(p->getType() == Piece_T::PAWN){ // If p is a pawn.
-                    const Pawn* pawnToCapture = dynamic_cast<const Pawn*>(p);
-                    if(pawnToCapture->getEnPassantCaptureStatus() && pawnToCapture->getColor() == Color_T::BLACK){
-                        return true;
-                    }
-                }
-            }
+    // The pawn that just moved two squares sits beside us, directly behind the target square.
+    size_t capturedRow = (pawnColor == Color_T::WHITE) ? moveData.toRow + 1 : moveData.toRow - 1;
+    Bitboard enemyPawns = m_position.pieces(oppositeColor(pawnColor), Piece_T::PAWN);
 
-            return false;
-        }
-    }
+    return (enemyPawns & squareBB(makeSquare(capturedRow, moveData.toCol))) != EMPTY_BB;
 }
 
 Piece_T Board::_charToPieceType(char c) {
@@ -1877,21 +1360,10 @@ Piece_T Board::_charToPieceType(char c) {
     }
 }
 
-const King* Board::getBlackKing() const { return m_blackKing; }
-const King* Board::getWhiteKing() const { return m_whiteKing; }
+std::unique_ptr<Piece> Board::_createPiece(PieceCode code, const Square& square) const {
+    Piece_T type = pieceCodeType(code);
+    Color_T color = pieceCodeColor(code);
 
-void Board::_setBlackKing(King* newKing) {
-    m_blackKing = newKing;
-}
-
-void Board::_setWhiteKing(King* newKing) {
-    m_whiteKing = newKing;
-}
-
-std::unique_ptr<Piece> Board::_createPiece(char pieceChar, Color_T color, const Square& square) {
-    Piece_T type = _charToPieceType(pieceChar);
-
-    unsigned int row = square.getRow();
     switch(type) {
         case Piece_T::ROOK: 
             return std::make_unique<Rook>(type, color, square, *this);
@@ -1901,43 +1373,10 @@ std::unique_ptr<Piece> Board::_createPiece(char pieceChar, Color_T color, const
             return std::make_unique<Bishop>(type, color, square, *this);
         case Piece_T::QUEEN: 
             return std::make_unique<Queen>(type, color, square, *this); 
-        case Piece_T::KING: {
-            const std::string& castleRightsRef = m_fen.getCastlingRightsStr();
-            std::unique_ptr<King> king = std::make_unique<King>(type, color, square, *this); 
-
-            if(color == Color_T::BLACK){
-                _setBlackKing(king.get());
-                if (castleRightsRef.find('k') == std::string::npos){
-                    king->setCanCastleShort(false);
-                }
-                if (castleRightsRef.find('q') == std::string::npos){
-                    king->setCanCastleLong(false);
-                }
-            } else {
-                _setWhiteKing(king.get());
-                if (castleRightsRef.find('K') == std::string::npos){
-                    king->setCanCastleShort(false);
-                }
-                if (castleRightsRef.find('Q') == std::string::npos){
-                    king->setCanCastleLong(false);
-                }
-            }
-            
-            return king;
-        }
+        case Piece_T::KING:
+            return std::make_unique<King>(type, color, square, *this); 
         case Piece_T::PAWN:
-            if(color == Color_T::BLACK && row != 1){
-                std::unique_ptr<Pawn> p = std::make_unique<Pawn>(type, color, square, *this);
-                p->setHasMoved(true);
-                return p;
-            } else if (color == Color_T::WHITE && row != 6){
-                std::unique_ptr<Pawn> p = std::make_unique<Pawn>(type, color, square, *this);
-                p->setHasMoved(true);
-                return p;
-            } else {
-                return std::make_unique<Pawn>(type, color, square, *this);
-            }
-            
+            return std::make_unique<Pawn>(type, color, square, *this);
         default: throw std::invalid_argument("Invalid piece type");
     }
 }
@@ -1959,11 +1398,11 @@ std::string Board::boardToString() const {
             char pieceChar = ' ';
             
             // Get piece at this position (O(1) lookup)
-            const auto& piece = pieces[row][col];
-            if(piece) {
+            PieceCode piece = m_position.pieceOn(makeSquare(row, col));
+            if(piece != NO_PIECE) {
                 // Get piece type and color to determine character
-                Piece_T type = piece->getType();
-                Color_T color = piece->getColor();
+                Piece_T type = pieceCodeType(piece);
+                Color_T color = pieceCodeColor(piece);
                 
                 switch(type) {
                     case Piece_T::PAWN:   pieceChar = 'P'; break;
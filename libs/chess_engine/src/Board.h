@@ -9,7 +9,15 @@
 #include <ostream>
 #include <memory>
 #include <sstream>
+#include <vector>
+#include <string_view>
+#include <type_traits>
 #include "Rook.h"
+#include "Position.h"
+#include "AttackMap.h"
+#include "Zobrist.h"
+#include "BoardState.h"
+#include "MoveList.h"
 #include "chess_engine/FENString.h"
 
 /*
@@ -18,32 +26,40 @@
 class Board final {
     friend std::ostream& operator<<(std::ostream& output, const Board& board);
 
-    // Hypothetical board state for move simulation without modifying actual board
-    struct HypotheticalMove {
-        size_t fromRow, fromCol;
-        size_t toRow, toCol;
-        bool isEnPassant;
-        size_t enPassantCapturedRow, enPassantCapturedCol;
-        
-        HypotheticalMove(size_t fRow, size_t fCol, size_t tRow, size_t tCol, const Board& board);
-        bool isSquareOccupied(size_t row, size_t col, const Board& board) const;
-        const Piece* getPieceAt(size_t row, size_t col, const Board& board) const;
-        std::pair<size_t, size_t> getKingPosition(Color_T color, const Board& board) const;
-    };
-
-    // Struct to keep track of castling rights.
-    struct CastleRights {
-        bool whiteLong, whiteShort, blackLong, blackShort;
+    // Everything makeMove overwrites that unmakeMove cannot work out from the move itself.
+    struct UndoRecord {
+        Move move;
+        PieceCode captured; // NO_PIECE for quiet moves. For en passant, the captured pawn.
+        BoardState state;
     };
 
     public:
         // To determine a type of castle move.
         enum class Castle_T : unsigned int { BLACK_SHORT, BLACK_LONG, WHITE_SHORT, WHITE_LONG }; 
     
+        // Everything search needs from a position and nothing that points back into a Board,
+        // so it copies with a plain memcpy. Worker threads and queues take these, not FEN strings.
+        struct Snapshot {
+            Position position;
+            AttackMap attackMap;
+            BoardState state;
+        };
+
         Board();
         Board(const FENString& fen);
+        explicit Board(const Snapshot& snapshot);
         Board(const std::array<std::array<char, MAX_COLS>, MAX_ROWS>& initBoardMapping);
 
+        // Resets this board in place from a FEN (or the first fields of an EPD line) without allocating.
+        // Returns false and leaves the board untouched if the text is not a valid FEN.
+        bool setFromFen(std::string_view fen);
+
+        void setStartPosition(); // Resets this board in place to the start position.
+
+        // Resets this board in place to a snapshot, the move history starts over from there.
+        void setFromSnapshot(const Snapshot& snapshot);
+        Snapshot snapshot() const;
+
         const std::array<std::array<Square, MAX_COLS>, MAX_ROWS>& getBoard() const;
 
         const Square& getBoardAt(size_t row, size_t col) const;
@@ -51,16 +67,20 @@ class Board final {
 
         const Piece* getPieceAt(size_t row, size_t col) const;
 
-        const King* getBlackKing() const;
-        const King* getWhiteKing() const;
+        const Position& getPosition() const;
 
         bool getBlackKingInCheck() const;
         bool getWhiteKingInCheck() const;
+        Bitboard checkers() const; // Enemy pieces giving check to the side to move.
 
-        bool getCheckToResetEnPassant() const;
-        void setCheckToResetEnPassant(bool val);
+        size_t getEnPassantSquare() const; // NO_SQUARE when there is none.
+        Zobrist::Key key() const; // Zobrist hash of pieces, side to move, castling rights and en passant file.
+        bool hasCastleRight(Castle_T type) const;
 
-        std::string getFenStr() const;
+        // Longest FEN writeFen can produce, terminator included.
+        static constexpr size_t FEN_BUFFER_SIZE{128};
+        size_t writeFen(char* buffer, size_t bufferSize) const;
+        std::string getFenStr() const; // Allocating convenience wrapper around writeFen.
 
         void printBoard() const;
         std::string boardToString() const;
@@ -75,67 +95,87 @@ class Board final {
 
         bool pawnCanPromote(const Square& to, Color_T color) const;
 
-        // if a move is legal returns true, else false.
-        bool isLegalMove(const Square& from, const Square& to, const Piece* movingPiece) const;
+        // Pattern check for whatever piece stands on fromSq, ignores turn and king safety.
+        bool isValidPattern(size_t fromSq, size_t toSq) const;
 
-        // Updates board and pieces.
-        Game_Status moveTo(Square& from, Square& to);
-        
-        // Version for perft that specifies promotion piece without user interaction
-        Game_Status moveTo(Square& from, Square& to, Piece_T promotionPiece);
+        // Why a move can or cannot be played by the side to move. Never throws, safe on engine paths.
+        MoveCheck_T checkMove(size_t fromSq, size_t toSq) const noexcept;
+        MoveCheck_T checkMove(const Square& from, const Square& to) const noexcept;
 
-        // Convert chess notation (e.g. "E4") to row/col coordinates
-        void notationToCoords(const std::string& notation, unsigned int& row, unsigned int& col) const;
-        std::string coordsToNotation(size_t& row, size_t& col) const;
+        // checkMove for the interactive front end, throws std::invalid_argument with a readable reason.
+        bool isLegalMove(const Square& from, const Square& to) const;
 
-    private:
-        struct HypotheticalMoveValidator {
-            static bool canPieceAttackSquare(const Piece* piece, size_t pieceRow, size_t pieceCol, 
-                                           size_t targetRow, size_t targetCol, 
-                                           const HypotheticalMove& move, const Board& board);
-            
-            static bool isPathClear(size_t fromRow, size_t fromCol, size_t toRow, size_t toCol,
-                                  const HypotheticalMove& move, const Board& board);
-        };
-
-        std::array<std::array<Square, MAX_COLS>, MAX_ROWS> board;
-        std::array<std::array<std::unique_ptr<Piece>, MAX_COLS>, MAX_ROWS> pieces;
-
-        const Piece* m_lastPieceMoved;
-        CastleRights m_castleRights;
-        FENString m_fen;
-        bool m_checkToResetEnPassant;
-        bool m_whiteKingInCheck;
-        bool m_blackKingInCheck;
-
-        size_t m_totalMoves;
-        size_t m_totalHalfMoves;
+        // Fills moves (cleared first) with the side to move's moves of the requested kind.
+        void generateMoves(MoveList& moves, GenMode_T mode) const;
+        void generateLegalMoves(MoveList& moves) const;
+        Color_T getActiveColor() const;
 
-        const King* m_whiteKing;
-        const King* m_blackKing;
+        // Plays a move if it is legal, returns false otherwise. No game status is worked out here,
+        // ask status() afterwards when it is actually needed.
+        bool moveTo(Square& from, Square& to);
         
-        void _updateFen();
+        // Version for perft that specifies promotion piece without user interaction
+        bool moveTo(Square& from, Square& to, Piece_T promotionPiece);
+        bool moveTo(Move move);
 
-        void _initCastleRights(std::string fenCastleRights);
-        void _initEnPassantCheck(std::string fenEnPassantStr);
+        // Checkmate, any draw (DRAW_END), check or CONTINUE for the side to move. Runs the move generator.
+        Game_Status status() const;
 
-        void _setBlackKingInCheck(bool);
-        void _setWhiteKingInCheck(bool);
-        
-        // Helper function to simulate the board state after a move, then checks if it leaves the king in check.
-        bool _wouldLeaveKingInCheck(const Square& from, const Square& to, Color_T movingPieceColor) const;
+        // Draws by rule that need no move generation: the fifty-move rule, insufficient material, or the
+        // current position having occurred `occurrences` times. Games use three, search can pass two.
+        // Does not look for mate, so a mate delivered on the hundredth halfmove still reads as a draw here.
+        bool isDraw(unsigned int occurrences = 3) const;
+        bool isInsufficientMaterial() const;
 
-        void _setBlackKing(King*);
-        void _setWhiteKing(King*);
+        // Search interface. Plays or takes back a legal move on the bitboard core and the game state only.
+        // The Piece/Square facade is only marked stale, getPieceAt rebuilds it when it is next needed.
+        void makeMove(Move move);
+        void unmakeMove();
 
-        bool _kingInCheck(const Piece* king) const;
-        bool _kingInCheck(const Piece* king, const std::array<std::array<std::unique_ptr<Piece>, MAX_COLS>, MAX_ROWS>& piecesCopy) const;
-        bool _checkCheckmate() const;
-        bool _checkDraw(Color_T) const;
+        // Convert chess notation (e.g. "E4") to row/col coordinates
+        void notationToCoords(const std::string& notation, unsigned int& row, unsigned int& col) const;
+        std::string coordsToNotation(size_t& row, size_t& col) const;
+
+    private:
+        // Object view of m_position, rebuilt lazily by _syncFacade.
+        mutable std::array<std::array<Square, MAX_COLS>, MAX_ROWS> board;
+        mutable std::array<std::array<std::unique_ptr<Piece>, MAX_COLS>, MAX_ROWS> pieces;
+        mutable bool m_facadeStale{true};
+
+        Position m_position; // Bitboard core, all validation and move execution runs on this.
+        AttackMap m_attackMap; // Squares each piece and side attacks, follows m_position move by move.
+
+        BoardState m_state; // Side to move, castling, en passant, clocks and key.
+        std::vector<UndoRecord> m_history;
+
+        Zobrist::Key _computeKey() const;
+        unsigned int _repetitions() const; // Earlier occurrences of the current position.
+        Zobrist::Key _enPassantKey() const; // 0 unless the side to move can actually capture en passant.
+        template<Color_T SideToMove> Zobrist::Key _enPassantKey() const;
+
+        void _initSquares();
+        void _resetDerivedState();
+        void _syncFacade() const;
+
+        // Generation and make/unmake are instantiated once per color, so pawn directions, home ranks and
+        // promotion rows are constants. The untemplated entry points are the only place the color is tested.
+        void _generateMoves(MoveList& moves, GenMode_T mode, Color_T us) const;
+        template<Color_T Us> void _generateMoves(MoveList& moves, GenMode_T mode) const;
+        template<Color_T Us> void _generateEvasions(MoveList& moves, GenMode_T mode, size_t kingSq,
+                                                    Bitboard checkers, Bitboard pinned, Bitboard targets) const;
+        template<Color_T Us> Bitboard _pinnedPieces(size_t kingSq) const;
+        template<Color_T Us> void _addPawnMoves(MoveList& moves, GenMode_T mode, Bitboard checkMask,
+                                                Bitboard pinned, size_t kingSq, bool legal) const;
+        template<Color_T Us> void _addPieceMoves(MoveList& moves, Bitboard targets, Bitboard pinned, size_t kingSq) const;
+        template<Color_T Us> void _addKingMoves(MoveList& moves, Bitboard targets, size_t kingSq) const;
+        template<Color_T Us> void _addCastleMoves(MoveList& moves) const;
+        template<Color_T Us, bool IsShort> bool _canCastle() const;
+        template<Color_T Us> void _makeMove(Move move);
+        template<Color_T Us> void _unmakeMove();
+        bool _isGeneratedLegal(size_t fromSq, size_t toSq) const;
+
+        bool _kingInCheck(Color_T color) const;
 
-        // Automatically moves rook to correct location
-        void _castleRookMove(Castle_T);
-        void _updateRookData(Rook* rook);
         bool _prelimMoveCheck(const MoveCoordsData&) const;
 
         // Two step move
@@ -148,17 +188,14 @@ class Board final {
 
         // Pawn attacking
         bool _isValidAttackMove(Color_T pawnColor, const MoveCoordsData& moveData, bool toSquareOccupied) const;
-        bool _isAttackRightMove(Color_T pawnColor, const MoveCoordsData& moveData) const;
-        bool _isAttackLeftMove(Color_T pawnColor, const MoveCoordsData& moveData) const;
         bool _isValidEnPassant(Color_T pawnColor, const MoveCoordsData& moveData, bool toSquareOccupied) const;
 
-        bool _checkDiagBlocked(const MoveCoordsData&, int deltaRow, int deltaCol) const;
-        bool _checkRankFileBlocked(const MoveCoordsData& moveData, int deltaRow, int deltaCol) const;
-
         bool _isValidCastleMove(const MoveCoordsData& moveData, Color_T kingColor) const;
         std::array<std::array<Square, MAX_COLS>, MAX_ROWS>& getBoard();
 
         Piece_T _promptForPromotion() const;
         Piece_T _charToPieceType(char c);
-        std::unique_ptr<Piece> _createPiece(char pieceChar, Color_T color, const Square& square);
-};
\ No newline at end of file
+        std::unique_ptr<Piece> _createPiece(PieceCode code, const Square& square) const;
+};
+
+static_assert(std::is_trivially_copyable_v<Board::Snapshot>, "Snapshots are copied between threads with memcpy");
\ No newline at end of file
@@ -0,0 +1,52 @@
+#pragma once
+#include "chess_engine/Types.h"
+#include "Bitboard.h"
+#include "Zobrist.h"
+#include <array>
+#include <cstdint>
+#include <type_traits>
+
+/*
+    Game state that cannot be read off the piece placement: side to move, castling rights,
+    en passant target, the two move clocks and the Zobrist key. Plain data, so makeMove saves
+    the whole block in the undo record and unmakeMove puts it straight back.
+*/
+struct BoardState {
+    // Castling rights bits. A set bit means the right is still available.
+    static constexpr std::uint8_t WHITE_SHORT{1};
+    static constexpr std::uint8_t WHITE_LONG{2};
+    static constexpr std::uint8_t BLACK_SHORT{4};
+    static constexpr std::uint8_t BLACK_LONG{8};
+    static constexpr std::uint8_t ALL_CASTLING{WHITE_SHORT | WHITE_LONG | BLACK_SHORT | BLACK_LONG};
+
+    Zobrist::Key key{0};
+    std::uint16_t halfMoves{0};
+    std::uint16_t fullMoves{1};
+    Color_T sideToMove{Color_T::WHITE};
+    std::uint8_t castling{0};
+    std::uint8_t epSquare{NO_SQUARE}; // NO_SQUARE when there is no en passant target.
+
+    // Rights that survive a move touching sq. Moving from or onto a king or rook home square
+    // clears the rights tied to it, so a move is just castling &= CASTLING_KEPT[from] & CASTLING_KEPT[to].
+    static constexpr std::array<std::uint8_t, NUM_SQUARES> CASTLING_KEPT = [] {
+        std::array<std::uint8_t, NUM_SQUARES> kept{};
+        kept.fill(ALL_CASTLING);
+        kept[makeSquare(0, 4)] &= static_cast<std::uint8_t>(~(BLACK_SHORT | BLACK_LONG)); // e8
+        kept[makeSquare(0, 0)] &= static_cast<std::uint8_t>(~BLACK_LONG); // a8
+        kept[makeSquare(0, MAX_COLS - 1)] &= static_cast<std::uint8_t>(~BLACK_SHORT); // h8
+        kept[makeSquare(MAX_ROWS - 1, 4)] &= static_cast<std::uint8_t>(~(WHITE_SHORT | WHITE_LONG)); // e1
+        kept[makeSquare(MAX_ROWS - 1, 0)] &= static_cast<std::uint8_t>(~WHITE_LONG); // a1
+        kept[makeSquare(MAX_ROWS - 1, MAX_COLS - 1)] &= static_cast<std::uint8_t>(~WHITE_SHORT); // h1
+        return kept;
+    }();
+
+    static constexpr std::uint8_t castleBit(Color_T color, bool isShort) {
+        if(color == Color_T::WHITE) {
+            return isShort ? WHITE_SHORT : WHITE_LONG;
+        }
+        return isShort ? BLACK_SHORT : BLACK_LONG;
+    }
+};
+
+static_assert(std::is_trivially_copyable_v<BoardState>);
+static_assert(NO_SQUARE <= UINT8_MAX, "epSquare stores NO_SQUARE in a byte");
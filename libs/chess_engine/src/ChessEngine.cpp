@@ -1,13 +1,20 @@
 #include "chess_engine/ChessEngine.h"
 #include "Board.h"
+#include "Attacks.h"
+#include "WorkStealingPool.h"
+#include "PerftHash.h"
+#include "PerftStats.h"
+#include <algorithm>
+#include <cctype>
 #include <iostream>
+#include <new>
 #include <vector>
 #include <thread>
 #include <mutex>
-#include <future>
 #include <sstream>
 #include <random>
 #include <chrono>
+#include <cstdint>
 #include <atomic>
 #include <condition_variable>
 #include <fstream>
@@ -30,15 +37,30 @@ Regarding Perft:
 */
 
 const ChessEngine::EngineID ChessEngine::engineID = {"Wazzu Engine", "Jamieson Mansker"};
-const ChessEngine::EngineOptionNames ChessEngine::engineOptionNames = {"Threads"};
+const ChessEngine::EngineOptionNames ChessEngine::engineOptionNames = {"Threads", "PerftSplitPly", "PerftHash", "PerftBulkCount", "PerftStats"};
 
-ChessEngine::ChessEngine(FENString fen) : m_fen{fen}, m_board{std::make_unique<Board>(fen)} {
-    // Open UCI log file - overwrite for each new session
-    m_uciLog.open("ucilog.txt", std::ios::out | std::ios::trunc);
-    if (m_uciLog.is_open()) {
-        m_uciLog << "=== New Chess Engine Session Started ===" << std::endl;
-        m_uciLog.flush();
+namespace {
+    // Ranges advertised for the spin options, the setters clamp to the same bounds.
+    constexpr unsigned int MAX_THREADS{1024};
+    constexpr unsigned int MIN_PERFT_SPLIT_PLY{1};
+    constexpr unsigned int MAX_PERFT_SPLIT_PLY{8};
+}
+
+ChessEngine::ChessEngine() : m_board{std::make_unique<Board>()} {}
+
+ChessEngine::ChessEngine(FENString fen) : m_board{std::make_unique<Board>(fen)} {}
+
+// The log is opened on first use, so engines that never write to it (Game, perft) never touch the file.
+bool ChessEngine::_openLog() const {
+    if (!m_uciLogOpened) {
+        m_uciLogOpened = true;
+        // Overwrite for each new session
+        m_uciLog.open("ucilog.txt", std::ios::out | std::ios::trunc);
+        if (m_uciLog.is_open()) {
+            m_uciLog << "=== New Chess Engine Session Started ===" << std::endl;
+        }
     }
+    return m_uciLog.is_open();
 }
 
 ChessEngine::~ChessEngine() {
@@ -78,105 +100,32 @@ void ChessEngine::uciStart() {
 }
 
 void ChessEngine::_makeUciMove(const std::string& uciMove) {
-    try {
-        if (uciMove.length() < 4) return;
-        
-        // Parse UCI move format (e.g., "e2e4", "e7e8q" for promotion)
-        char fromFile = uciMove[0];
-        char fromRank = uciMove[1];
-        char toFile = uciMove[2];
-        char toRank = uciMove[3];
-        
-        // Validate coordinates
-        if (fromFile < 'a' || fromFile > 'h' || toFile < 'a' || toFile > 'h' ||
-            fromRank < '1' || fromRank > '8' || toRank < '1' || toRank > '8') {
+    // Parse UCI move format (e.g., "e2e4", "e7e8q" for promotion)
+    Move parsed = Move::fromUci(uciMove);
+    if (parsed.isNone()) return;
+
+    // Match against the legal moves so castling and en passant pick up their flags.
+    MoveList legalMoves;
+    m_board->generateLegalMoves(legalMoves);
+    for (Move move : legalMoves) {
+        if (move.from() == parsed.from() && move.to() == parsed.to() && move.promotion() == parsed.promotion()) {
+            m_board->moveTo(move); // No status needed, the GUI keeps track of the game.
             return;
         }
-        
-        // Convert to array indices (a1 = row 7, col 0)
-        size_t fromRow = 8 - (fromRank - '0');
-        size_t fromCol = fromFile - 'a';
-        size_t toRow = 8 - (toRank - '0');
-        size_t toCol = toFile - 'a';
-        
-        MoveCoordsData move = {fromRow, fromCol, toRow, toCol};
-        
-        // Check for promotion
-        if (uciMove.length() == 5) {
-            char promotionChar = uciMove[4];
-            Piece_T promotionPiece;
-            switch (promotionChar) {
-                case 'q': promotionPiece = Piece_T::QUEEN; break;
-                case 'r': promotionPiece = Piece_T::ROOK; break;
-                case 'b': promotionPiece = Piece_T::BISHOP; break;
-                case 'n': promotionPiece = Piece_T::KNIGHT; break;
-                default: return;
-            }
-            isValidMove(move, promotionPiece);
-        } else {
-            isValidMove(move);
-        }
-    } catch (const std::exception& e) {
-        // Log error but don't crash - probably corrupted FEN
-        if (m_uciLog.is_open()) {
-            m_uciLog << "ERROR in _makeUciMove: " << e.what() << " for move: " << uciMove << std::endl;
-            m_uciLog << "Current FEN: " << m_fen.getFen() << std::endl;
-            m_uciLog.flush();
-        }
-        // Don't process this move, continue with current position
-        return;
     }
+
+    // Log error but don't crash - probably corrupted FEN
+    if (_openLog()) {
+        m_uciLog << "ERROR in _makeUciMove: Illegal move for move: " << uciMove << std::endl;
+        m_uciLog << "Current FEN: " << m_board->getFenStr() << std::endl;
+        m_uciLog.flush();
+    }
+    // Don't process this move, continue with current position
 }
 
 std::string ChessEngine::_getRandomValidMove() const {
-    std::vector<std::string> validMoves;
-    
-    // Generate all possible moves for the current player
-    for(size_t fromRow = 0; fromRow < MAX_ROWS; ++fromRow) {
-        for(size_t fromCol = 0; fromCol < MAX_COLS; ++fromCol) {
-            const Piece* piece = m_board->getPieceAt(fromRow, fromCol);
-            if(!piece) continue;
-            
-            // Get the current active player
-            char activePlayer = m_fen.getActiveTurn();
-            Color_T currentPlayerColor = (activePlayer == 'w') ? Color_T::WHITE : Color_T::BLACK;
-            
-            if(piece->getColor() != currentPlayerColor) continue;
-            
-            // Try all possible destination squares for this piece
-            for(size_t toRow = 0; toRow < MAX_ROWS; ++toRow) {
-                for(size_t toCol = 0; toCol < MAX_COLS; ++toCol) {
-                    try {
-                        Square& from = m_board->getBoardAt(fromRow, fromCol);
-                        Square& to = m_board->getBoardAt(toRow, toCol);
-                        
-                        if(m_board->isLegalMove(from, to, piece)) {
-                            // Convert coordinates to UCI notation
-                            char fromFile = 'a' + fromCol;
-                            char fromRank = '8' - fromRow;
-                            char toFile = 'a' + toCol;
-                            char toRank = '8' - toRow;
-                            
-                            // Check if this is a pawn promotion move
-                            if(piece->getType() == Piece_T::PAWN && m_board->pawnCanPromote(to, piece->getColor())) {
-                                // Add all promotion options
-                                std::vector<char> promotions = {'q', 'r', 'b', 'n'};
-                                for(char promo : promotions) {
-                                    std::string move = std::string() + fromFile + fromRank + toFile + toRank + promo;
-                                    validMoves.push_back(move);
-                                }
-                            } else {
-                                std::string move = std::string() + fromFile + fromRank + toFile + toRank;
-                                validMoves.push_back(move);
-                            }
-                        }
-                    } catch (const std::exception& e) {
-                        continue;
-                    }
-                }
-            }
-        }
-    }
+    MoveList validMoves;
+    m_board->generateLegalMoves(validMoves);
     
     if (validMoves.empty()) {
         return "a1a1"; // No valid moves return a1a1
@@ -187,14 +136,14 @@ std::string ChessEngine::_getRandomValidMove() const {
     std::mt19937 gen(rd());
     std::uniform_int_distribution<> dist(0, validMoves.size() - 1);
     
-    return validMoves[dist(gen)];
+    return validMoves[dist(gen)].toUci();
 }
 std::string ChessEngine::_collectSignal() const {
     std::string signal;
     std::getline(std::cin, signal);
     
     // Log the incoming command
-    if (m_uciLog.is_open()) {
+    if (_openLog()) {
         m_uciLog << "GUI -> Engine: " << signal << std::endl;
         m_uciLog.flush();
     }
@@ -213,15 +162,13 @@ void ChessEngine::_executeSignal(std::string signal) {
         std::cout << "readyok" << std::endl;
     } else if (command == "ucinewgame") {
         // Reset to starting position
-        m_fen = FEN_STARTING_POS;
-        m_board = std::make_unique<Board>(m_fen);
+        m_board->setStartPosition();
     } else if (command == "position") {
         std::string posType;
         iss >> posType;
         
         if (posType == "startpos") {
-            m_fen = FEN_STARTING_POS;
-            m_board = std::make_unique<Board>(m_fen);
+            m_board->setStartPosition();
             
             std::string movesKeyword;
             iss >> movesKeyword;
@@ -245,8 +192,11 @@ void ChessEngine::_executeSignal(std::string signal) {
                 fenStr += token;
             }
             
-            m_fen = FENString(fenStr);
-            m_board = std::make_unique<Board>(m_fen);
+            // Reset the current board in place, a FEN that does not parse leaves the position as it was.
+            if (!m_board->setFromFen(fenStr)) {
+                _logOutput("ERROR invalid FEN: " + fenStr);
+                return;
+            }
             
             if (token == "moves") {
                 std::string move;
@@ -270,11 +220,10 @@ void ChessEngine::_executeSignal(std::string signal) {
             std::cout << "bestmove 0000" << std::endl;
         }
     } else if (command == "setoption") {
-        // Handle setoption commands (for now just acknowledge)
         // Format: setoption name <name> value <value>
         std::string name, nameValue, value, valueValue;
         iss >> name >> nameValue >> value >> valueValue;
-        // For now, just acknowledge - could store thread count etc.
+        _setOption(nameValue, valueValue);
     }
 }
 
@@ -313,6 +262,7 @@ void ChessEngine::_processCommand(const std::string& signal) {
         case UCICommand_T::UCI:
             _printIdentity();
             _printOptions();
+            _printInfo("slider attacks: " + std::string(Attacks::backendName()));
 
             response = "uciok";
             break;
@@ -326,8 +276,7 @@ void ChessEngine::_processCommand(const std::string& signal) {
             break;
     
         case UCICommand_T::UCINEWGAME: // Reset to starting position
-            m_fen = FEN_STARTING_POS;
-            m_board = std::make_unique<Board>(m_fen);
+            m_board->setStartPosition();
             break;
         
         case UCICommand_T::POSITION: {
@@ -335,8 +284,7 @@ void ChessEngine::_processCommand(const std::string& signal) {
             iss >> posType;
             
             if (posType == "startpos") {
-                m_fen = FEN_STARTING_POS;
-                m_board = std::make_unique<Board>(m_fen);
+                m_board->setStartPosition();
                 
                 std::string movesKeyword;
                 iss >> movesKeyword;
@@ -361,8 +309,11 @@ void ChessEngine::_processCommand(const std::string& signal) {
                     fenStr += token;
                 }
                 
-                m_fen = FENString(fenStr);
-                m_board = std::make_unique<Board>(m_fen);
+                // Reset the current board in place, a FEN that does not parse leaves the position as it was.
+                if (!m_board->setFromFen(fenStr)) {
+                    _logOutput("ERROR invalid FEN: " + fenStr);
+                    return;
+                }
                 
                 if (token == "moves") {
                     std::string move;
@@ -385,14 +336,26 @@ void ChessEngine::_processCommand(const std::string& signal) {
             // Check for ponder mode
             std::string param;
             bool isPonder = false;
+            bool isPerft = false;
             while (iss >> param) {
                 if (param == "ponder") {
                     isPonder = true;
                     break;
+                } else if (param == "perft") {
+                    isPerft = true;
+                    break;
                 }
             }
             
-            if (isPonder) {
+            if (isPerft) {
+                // go perft <depth>, counts from the current position and prints the per move split.
+                unsigned int depth{0};
+                if (iss >> depth) {
+                    perft(depth);
+                } else {
+                    logError = "Invalid Command: go perft lacks a depth";
+                }
+            } else if (isPonder) {
                 m_isPondering.store(true);
                 // In ponder mode, we would start thinking but wait for ponderhit or stop
                 // For now, just acknowledge ponder mode
@@ -436,7 +399,7 @@ void ChessEngine::_processCommand(const std::string& signal) {
         case UCICommand_T::SETOPTION: {
             std::string name, nameValue, value, valueValue;
             iss >> name >> nameValue >> value >> valueValue;
-            // For now, just acknowledge - could store thread count etc.
+            _setOption(nameValue, valueValue);
             break;
         }
     }
@@ -474,17 +437,21 @@ UCICommand_T ChessEngine::_commandHit(const std::string& in) const {
     }
 }
 
+MoveCheck_T ChessEngine::checkMove(MoveCoordsData move) const noexcept {
+    if(move.fromRow >= MAX_ROWS || move.fromCol >= MAX_COLS || move.toRow >= MAX_ROWS || move.toCol >= MAX_COLS) {
+        return MoveCheck_T::ILLEGAL_PATTERN;
+    }
+    return m_board->checkMove(move.fromRow * MAX_COLS + move.fromCol, move.toRow * MAX_COLS + move.toCol);
+}
+
 // Actually is modifying the m_board states... TODO
 Game_Status ChessEngine::isValidMove(MoveCoordsData move) {
     Square& from = m_board->getBoardAt(move.fromRow, move.fromCol);
     Square& to = m_board->getBoardAt(move.toRow, move.toCol);
 
-    const Piece* p = m_board->getPieceAt(move.fromRow, move.fromCol);
-    
-    if(m_board->isLegalMove(from, to, p)){
-        Game_Status gameStatus = m_board->moveTo(from, to);
-        m_fen.setFen(m_board->getFenStr());
-        return gameStatus;
+    if(m_board->checkMove(from, to) == MoveCheck_T::LEGAL){
+        m_board->moveTo(from, to);
+        return m_board->status();
     } else {
         return Game_Status::INVALID;
     }
@@ -494,12 +461,18 @@ Game_Status ChessEngine::isValidMove(MoveCoordsData move, Piece_T promotionPiece
     Square& from = m_board->getBoardAt(move.fromRow, move.fromCol);
     Square& to = m_board->getBoardAt(move.toRow, move.toCol);
 
-    const Piece* p = m_board->getPieceAt(move.fromRow, move.fromCol);
-    
-    if(m_board->isLegalMove(from, to, p)){
-        Game_Status gameStatus = m_board->moveTo(from, to, promotionPiece);
-        m_fen.setFen(m_board->getFenStr());
-        return gameStatus;
+    if(m_board->checkMove(from, to) == MoveCheck_T::LEGAL){
+        m_board->moveTo(from, to, promotionPiece);
+        return m_board->status();
+    } else {
+        return Game_Status::INVALID;
+    }
+}
+
+Game_Status ChessEngine::isValidMove(Move move) {
+    if(m_board->checkMove(move.from(), move.to()) == MoveCheck_T::LEGAL){
+        m_board->moveTo(move);
+        return m_board->status();
     } else {
         return Game_Status::INVALID;
     }
@@ -517,13 +490,103 @@ void ChessEngine::_printIdentity() const {
 }
 
 void ChessEngine::_printOptions() const {
-    std::string optionOutput = "option name " + engineOptionNames.threads + " type spin default 1 min 1 max 1024";
+    // Threads 0, the default, means one thread per hardware thread.
+    std::string optionOutput = "option name " + engineOptionNames.threads + " type spin default 0 min 0 max " + std::to_string(MAX_THREADS);
+    std::cout << optionOutput << std::endl;
+    _logOutput(optionOutput);
+
+    optionOutput = "option name " + engineOptionNames.perftSplitPly + " type spin default 2 min " + std::to_string(MIN_PERFT_SPLIT_PLY)
+                 + " max " + std::to_string(MAX_PERFT_SPLIT_PLY);
+    std::cout << optionOutput << std::endl;
+    _logOutput(optionOutput);
+
+    optionOutput = "option name " + engineOptionNames.perftHash + " type spin default 0 min 0 max " + std::to_string(PerftHash::MAX_MEGABYTES);
+    std::cout << optionOutput << std::endl;
+    _logOutput(optionOutput);
+
+    optionOutput = "option name " + engineOptionNames.perftBulkCount + " type check default true";
     std::cout << optionOutput << std::endl;
     _logOutput(optionOutput);
+
+    optionOutput = "option name " + engineOptionNames.perftStats + " type check default false";
+    std::cout << optionOutput << std::endl;
+    _logOutput(optionOutput);
+}
+
+// Unknown names, values that are not numbers and numbers outside the advertised range are ignored, as UCI asks.
+void ChessEngine::_setOption(const std::string& name, const std::string& value) {
+    if (name == engineOptionNames.perftBulkCount || name == engineOptionNames.perftStats) {
+        if (value != "true" && value != "false") {
+            _logOutput("ERROR invalid value for option " + name + ": " + value);
+        } else if (name == engineOptionNames.perftBulkCount) {
+            setPerftBulkCounting(value == "true");
+        } else {
+            setPerftStatistics(value == "true");
+        }
+        return;
+    }
+
+    // std::stoul would take "-1" and wrap it, so the value has to start with a digit.
+    unsigned long int number{0};
+    bool valid = !value.empty() && std::isdigit(static_cast<unsigned char>(value[0]));
+    try {
+        number = valid ? std::stoul(value) : 0;
+    } catch (const std::exception&) {
+        valid = false;
+    }
+    if (!valid) {
+        _logOutput("ERROR invalid value for option " + name + ": " + value);
+        return;
+    }
+
+    if (name == engineOptionNames.threads) {
+        if (number > MAX_THREADS) {
+            _logOutput("ERROR value out of range for option " + name + ": " + value);
+            return;
+        }
+        setThreads(static_cast<unsigned int>(number));
+    } else if (name == engineOptionNames.perftSplitPly) {
+        if (number < MIN_PERFT_SPLIT_PLY || number > MAX_PERFT_SPLIT_PLY) {
+            _logOutput("ERROR value out of range for option " + name + ": " + value);
+            return;
+        }
+        setPerftSplitPly(static_cast<unsigned int>(number));
+    } else if (name == engineOptionNames.perftHash) {
+        if (number > PerftHash::MAX_MEGABYTES) {
+            _logOutput("ERROR value out of range for option " + name + ": " + value);
+            return;
+        }
+        setPerftHashSize(number);
+    }
+}
+
+void ChessEngine::setThreads(unsigned int threads) {
+    m_threads = std::min(threads, MAX_THREADS);
+}
+
+void ChessEngine::setPerftSplitPly(unsigned int ply) {
+    m_perftSplitPly = std::clamp(ply, MIN_PERFT_SPLIT_PLY, MAX_PERFT_SPLIT_PLY);
+}
+
+void ChessEngine::setPerftBulkCounting(bool enabled) {
+    m_perftBulkCounting = enabled;
+}
+
+void ChessEngine::setPerftStatistics(bool enabled) {
+    m_perftStatistics = enabled;
+}
+
+// The table itself is reallocated on the next perft.
+void ChessEngine::setPerftHashSize(size_t megabytes) {
+    megabytes = std::min(megabytes, PerftHash::MAX_MEGABYTES);
+    if (megabytes != m_perftHashMegabytes) {
+        m_perftHashMegabytes = megabytes;
+        m_perftHash.reset();
+    }
 }
 
 void ChessEngine::_logOutput(const std::string& output) const {
-    if (m_uciLog.is_open()) {
+    if (_openLog()) {
         m_uciLog << "Engine -> GUI: " << output << std::endl;
         m_uciLog.flush();
     }
@@ -538,13 +601,169 @@ void ChessEngine::_printInfo(const std::string& info) const {
 }
 
 // pubic version
-unsigned long int ChessEngine::perft(unsigned int depth) {
+std::uint64_t ChessEngine::perft(unsigned int depth) {
     return _perft(depth, true);
 }
 
-// recursive, greatly inefficient due to us making a ChessEngine obj each step.
-// Multi threaded inconsistency? TODO
-unsigned long int ChessEngine::_perft(unsigned int depth, bool showMoves) {
+namespace {
+    // Walks the tree on a single board, every makeMove is paired with an unmakeMove.
+    // With a hash, subtrees of depth 2 and more are looked up first and stored once counted.
+    // BulkCount answers the last ply with the size of the legal move list, without making any of the moves.
+    template<bool BulkCount>
+    std::uint64_t perftRecursive(Board& board, unsigned int depth, PerftHash* hash, PerftHash::Stats& stats) {
+        if (depth == 0) {
+            return 1;
+        }
+
+        std::uint64_t totalNodes = 0;
+        if(hash && depth >= 2) {
+            ++stats.probes;
+            if(hash->probe(board.key(), depth, totalNodes)) {
+                ++stats.hits;
+                return totalNodes;
+            }
+        }
+        
+        MoveList moves;
+        board.generateLegalMoves(moves);
+
+        if(BulkCount && depth == 1) {
+            return moves.size();
+        }
+
+        for(Move move : moves) {
+            board.makeMove(move);
+            totalNodes += perftRecursive<BulkCount>(board, depth - 1, hash, stats);
+            board.unmakeMove();
+        }
+
+        // Depth 1 is never probed, storing it would only push out entries that are.
+        if(hash && depth >= 2) {
+            hash->store(board.key(), depth, totalNodes);
+        }
+        return totalNodes;
+    }
+
+    std::uint64_t perftRecursive(Board& board, unsigned int depth, bool bulkCount, PerftHash* hash, PerftHash::Stats& stats) {
+        return bulkCount ? perftRecursive<true>(board, depth, hash, stats) : perftRecursive<false>(board, depth, hash, stats);
+    }
+
+    // Plays one leaf move and files it under every category it belongs to.
+    void countLeafMove(Board& board, Move move, PerftStats& stats) {
+        ++stats.nodes;
+        if(move.isEnPassant()) {
+            ++stats.enPassant;
+            ++stats.captures;
+        } else if(move.isCastling()) {
+            ++stats.castles;
+        } else if(!board.getPosition().isEmpty(move.to())) {
+            ++stats.captures;
+        }
+        if(move.isPromotion()) {
+            ++stats.promotions;
+        }
+
+        board.makeMove(move);
+        const Bitboard checkers = board.checkers();
+        if(checkers) {
+            ++stats.checks;
+
+            // Any checker other than the piece that just moved was uncovered. When castling the rook
+            // is the piece that moved as far as checks go.
+            Bitboard moved = squareBB(move.to());
+            if(move.isCastling()) {
+                size_t rookCol = squareCol(move.to()) > squareCol(move.from()) ? squareCol(move.to()) - 1 : squareCol(move.to()) + 1;
+                moved |= squareBB(makeSquare(squareRow(move.to()), rookCol));
+            }
+            if(popCount(checkers) > 1) {
+                ++stats.doubleChecks;
+            } else if(checkers & ~moved) {
+                ++stats.discoveredChecks;
+            }
+
+            MoveList replies;
+            board.generateLegalMoves(replies);
+            if(replies.size() == 0) { ++stats.checkmates; }
+        }
+        board.unmakeMove();
+    }
+
+    // Statistics need every leaf made, so there is no bulk counting and no hash on this walk.
+    void perftStatsRecursive(Board& board, unsigned int depth, PerftStats& stats) {
+        MoveList moves;
+        board.generateLegalMoves(moves);
+        for(Move move : moves) {
+            if(depth == 1) {
+                countLeafMove(board, move, stats);
+            } else {
+                board.makeMove(move);
+                perftStatsRecursive(board, depth - 1, stats);
+                board.unmakeMove();
+            }
+        }
+    }
+
+    void printStats(const PerftStats& stats) {
+        std::cout << "captures " << stats.captures << ", e.p. " << stats.enPassant << ", castles " << stats.castles
+                  << ", promotions " << stats.promotions << ", checks " << stats.checks
+                  << ", discovered checks " << stats.discoveredChecks << ", double checks " << stats.doubleChecks
+                  << ", checkmates " << stats.checkmates;
+    }
+}
+
+// Settings and results shared by every task of one perft run.
+struct ChessEngine::PerftRun {
+    WorkStealingPool& pool;
+    PerftHash* hash;
+    bool bulkCount;
+    bool statistics;
+    unsigned int splitPly;
+    std::vector<std::atomic<std::uint64_t>> rootNodes;
+    // One row of root move statistics per worker. A worker only ever touches its own row.
+    std::vector<PerftStats> workerStats;
+
+    PerftStats& statsFor(size_t root) { return workerStats[pool.currentWorker() * rootNodes.size() + root]; }
+};
+
+// One node of the split tree. Nodes above the split ply hand their children back to the pool as new
+// tasks, so a big subtree ends up spread over many deques. Below it the whole subtree is counted on
+// one board with make/unmake.
+struct ChessEngine::PerftTask {
+    PerftRun& run;
+    size_t root; // Index of the root move this node descends from.
+    Board::Snapshot snapshot;
+    unsigned int depth;
+    unsigned int ply;
+
+    void operator()() const {
+        Board board{snapshot};
+        if(ply >= run.splitPly || depth <= 1) {
+            std::uint64_t nodes{0};
+            if(run.statistics) {
+                PerftStats stats;
+                perftStatsRecursive(board, depth, stats);
+                run.statsFor(root) += stats;
+                nodes = stats.nodes;
+            } else {
+                PerftHash::Stats stats;
+                nodes = perftRecursive(board, depth, run.bulkCount, run.hash, stats);
+                if(run.hash) { run.hash->addStats(stats); }
+            }
+            run.rootNodes[root].fetch_add(nodes, std::memory_order_relaxed);
+            return;
+        }
+
+        MoveList moves;
+        board.generateLegalMoves(moves);
+        for(Move move : moves) {
+            board.makeMove(move);
+            run.pool.submit(PerftTask{run, root, board.snapshot(), depth - 1, ply + 1});
+            board.unmakeMove();
+        }
+    }
+};
+
+std::uint64_t ChessEngine::_perft(unsigned int depth, bool showMoves) {
     if (depth == 0) {
         return 1;
     }
@@ -554,201 +773,127 @@ unsigned long int ChessEngine::_perft(unsigned int depth, bool showMoves) {
         return _perftSingleThreaded(depth);
     }
     
-    // Display detected core count
-    unsigned int numCores = std::thread::hardware_concurrency();
-    if (numCores == 0) {
-        std::cout << "Hardware concurrency detection failed, using 4 cores as fallback" << std::endl;
-        numCores = 4;
-    } else {
-        std::cout << "Detected " << numCores << " CPU cores" << std::endl;
+    WorkStealingPool& pool = _perftPool();
+    PerftHash* hash = m_perftStatistics ? nullptr : _perftHash();
+    std::cout << "Using " << pool.size() << " threads, split at ply " << m_perftSplitPly << std::endl;
+    if (m_perftStatistics) {
+        std::cout << "Statistics on, every leaf move is made and classified" << std::endl;
+    } else if (!m_perftBulkCounting) {
+        std::cout << "Bulk counting off, every leaf move is made and unmade" << std::endl;
+    }
+    if (hash) {
+        hash->resetStats();
+        std::cout << "Perft hash: " << hash->megabytes() << " MB" << std::endl;
     }
     std::cout << "Calculating...\n" << std::endl;
     
     // Collect all valid moves first
-    // TODO THIS SHOULDN"T BE A CHESS ENGINE THING. should be a member of m_board in Board.
-    std::vector<std::tuple<MoveCoordsData, std::string, Piece_T>> validMoves;
+    MoveList validMoves;
+    m_board->generateLegalMoves(validMoves);
+
+    PerftRun run{pool, hash, m_perftBulkCounting, m_perftStatistics, m_perftSplitPly,
+                 std::vector<std::atomic<std::uint64_t>>(validMoves.size()), {}};
+    if (m_perftStatistics) {
+        run.workerStats.resize(static_cast<size_t>(pool.size()) * validMoves.size());
+    }
     
-    // Generate all possible moves for the current player.
-    // TODO, add states in Board to improve.
-    for(size_t fromRow = 0; fromRow < MAX_ROWS; ++fromRow) {
-        for(size_t fromCol = 0; fromCol < MAX_COLS; ++fromCol) {
-            const Piece* piece = m_board->getPieceAt(fromRow, fromCol);
-            if(!piece) {
-                continue; // Skip empty squares
-            }
-            
-            // Get the current active player fresh each iteration
-            char activePlayer = m_fen.getActiveTurn();
-            Color_T currentPlayerColor = (activePlayer == 'w') ? Color_T::WHITE : Color_T::BLACK;
-            
-            if(piece->getColor() != currentPlayerColor) {
-                continue; // Skip opponent pieces
-            }
-            
-            // Try all possible destination squares for this piece
-            for(size_t toRow = 0; toRow < MAX_ROWS; ++toRow) {
-                for(size_t toCol = 0; toCol < MAX_COLS; ++toCol) {
-                    MoveCoordsData move = {fromRow, fromCol, toRow, toCol};
-                    
-                    try {
-                        Square& from = m_board->getBoardAt(fromRow, fromCol);
-                        Square& to = m_board->getBoardAt(toRow, toCol);
-                        
-                        // Just check if move is legal without making it
-                        if(m_board->isLegalMove(from, to, piece)) {
-                            // Convert coordinates to algebraic notation
-                            size_t fromRowCopy = fromRow, fromColCopy = fromCol;
-                            size_t toRowCopy = toRow, toColCopy = toCol;
-                            std::string fromSquare = m_board->coordsToNotation(fromRowCopy, fromColCopy);
-                            std::string toSquare = m_board->coordsToNotation(toRowCopy, toColCopy);
-                            
-                            // Check if this is a pawn promotion move
-                            if(piece->getType() == Piece_T::PAWN && m_board->pawnCanPromote(to, piece->getColor())) {
-                                // Generate 4 separate moves for each promotion piece
-                                std::vector<Piece_T> promotionPieces = {Piece_T::QUEEN, Piece_T::ROOK, Piece_T::BISHOP, Piece_T::KNIGHT};
-                                std::vector<char> promotionSuffixes = {'q', 'r', 'b', 'n'};
-                                
-                                for(size_t i = 0; i < promotionPieces.size(); ++i) {
-                                    std::string moveNotation = fromSquare + toSquare + promotionSuffixes[i];
-                                    validMoves.emplace_back(move, moveNotation, promotionPieces[i]);
-                                }
-                            } else {
-                                std::string moveNotation = fromSquare + toSquare;
-                                validMoves.emplace_back(move, moveNotation, Piece_T::QUEEN); // Default, not used for non-promotions
-                            }
-                        }
-                    } catch (const std::exception& e) {
-                        continue;
-                    }
-                }
-            }
+    // Root moves are the first tasks, each splits further until the split ply.
+    Board board{m_board->snapshot()};
+    for(size_t i = 0; i < validMoves.size(); ++i) {
+        if (m_perftStatistics && depth == 1) {
+            // The root moves are the leaves, classify them here rather than from a task.
+            countLeafMove(board, validMoves[i], run.workerStats[i]);
+            run.rootNodes[i].store(1, std::memory_order_relaxed);
+            continue;
         }
+        board.makeMove(validMoves[i]);
+        pool.submit(PerftTask{run, i, board.snapshot(), depth - 1, 1});
+        board.unmakeMove();
     }
+    pool.wait();
     
-    // Process moves in parallel
-    // Each initial move will get its own thread...
-    std::vector<std::future<std::pair<std::string, unsigned long int>>> futures;
-    std::string currentFen = m_fen.getFen();
-    
-    for(const auto& moveData : validMoves) {
-        const auto& move = std::get<0>(moveData);
-        const auto& notation = std::get<1>(moveData);
-        const auto& promotionPiece = std::get<2>(moveData);
-        
-        futures.push_back(std::async(std::launch::async, [this, move, notation, promotionPiece, currentFen, depth]()-> std::pair<std::string, unsigned long int> {
-            try {
-                ChessEngine engine{FENString(currentFen)};
-                
-                // Check if this is a promotion move by looking at the notation
-                Game_Status moveResult;
-                if(notation.length() > 4 && (notation.back() == 'q' || notation.back() == 'r' || notation.back() == 'b' || notation.back() == 'n')) {
-                    moveResult = engine.isValidMove(move, promotionPiece);
-                } else {
-                    moveResult = engine.isValidMove(move);
-                }
-                
-                if(moveResult != Game_Status::INVALID) {
-                    unsigned long int nodes = engine._perftSingleThreaded(depth - 1);
-                    return {notation, nodes};
+    // Output results in root move order
+    std::uint64_t totalNodes = 0;
+    PerftStats totalStats;
+    for(size_t i = 0; i < validMoves.size(); ++i) {
+        std::uint64_t nodes = run.rootNodes[i].load(std::memory_order_relaxed);
+        if(nodes > 0) {
+            std::cout << validMoves[i].toUci() << ": " << nodes;
+            if (m_perftStatistics) {
+                PerftStats moveStats;
+                for(size_t worker = 0; worker < pool.size(); ++worker) {
+                    moveStats += run.workerStats[worker * validMoves.size() + i];
                 }
-            } catch (const std::exception& e) {}
-            return {notation, 0};
-        }));
-    }
-    
-    // Collect results and output them in order
-    unsigned long int totalNodes = 0;
-    for(size_t i = 0; i < futures.size(); ++i) {
-        auto result = futures[i].get();
-        if(result.second > 0) {
-            std::cout << result.first << ": " << result.second << std::endl;
-            totalNodes += result.second;
+                totalStats += moveStats;
+                std::cout << " (";
+                printStats(moveStats);
+                std::cout << ")";
+            }
+            std::cout << std::endl;
+            totalNodes += nodes;
         }
     }
     
-    std::cout << std::endl << "Nodes searched: " << totalNodes << std::endl << std::flush;
+    std::cout << std::endl << "Nodes searched: " << totalNodes << std::endl;
+    if (m_perftStatistics) {
+        printStats(totalStats);
+        std::cout << std::endl;
+    }
+    if (hash) {
+        PerftHash::Stats stats = hash->stats();
+        double hitRate = stats.probes ? 100.0 * static_cast<double>(stats.hits) / static_cast<double>(stats.probes) : 0.0;
+        std::cout << "Hash hits: " << stats.hits << " of " << stats.probes << " probes (" << hitRate << "%)" << std::endl;
+    }
+    std::cout << std::flush;
     return totalNodes;
 }
 
-// Does the recursive function for the thread.
-unsigned long int ChessEngine::_perftSingleThreaded(unsigned int depth) {
-    if (depth == 0) {
-        return 1;
+WorkStealingPool& ChessEngine::_perftPool() {
+    unsigned int threads = m_threads;
+    if (threads == 0) {
+        threads = std::thread::hardware_concurrency();
+        if (threads == 0) {
+            std::cout << "Hardware concurrency detection failed, using 4 cores as fallback" << std::endl;
+            threads = 4;
+        }
     }
-    
-    unsigned long int totalNodes = 0;
-    
-    // Generate all possible moves for the current player
-    for(size_t fromRow = 0; fromRow < MAX_ROWS; ++fromRow) {
-        for(size_t fromCol = 0; fromCol < MAX_COLS; ++fromCol) {
-            const Piece* piece = m_board->getPieceAt(fromRow, fromCol);
-            if(!piece) {
-                continue;
-            }
-            
-            // Get the current active player fresh each iteration
-            char activePlayer = m_fen.getActiveTurn();
-            Color_T currentPlayerColor = (activePlayer == 'w') ? Color_T::WHITE : Color_T::BLACK;
-            
-            if(piece->getColor() != currentPlayerColor) {
-                continue;
-            }
-            
-            // Try all possible destination squares for this piece
-            for(size_t toRow = 0; toRow < MAX_ROWS; ++toRow) {
-                for(size_t toCol = 0; toCol < MAX_COLS; ++toCol) {
-                    MoveCoordsData move = {fromRow, fromCol, toRow, toCol};
-                    
-                    try {
-                        Square& from = m_board->getBoardAt(fromRow, fromCol);
-                        Square& to = m_board->getBoardAt(toRow, toCol);
-                        
-                        // Just check if move is legal without making it
-                        if(m_board->isLegalMove(from, to, piece)) {
-                            // Check if this is a pawn promotion move
-                            if(piece->getType() == Piece_T::PAWN && m_board->pawnCanPromote(to, piece->getColor())) {
-                                // Generate 4 separate moves for each promotion piece
-                                std::vector<Piece_T> promotionPieces = {Piece_T::QUEEN, Piece_T::ROOK, Piece_T::BISHOP, Piece_T::KNIGHT};
-                                
-                                for(Piece_T promotionPiece : promotionPieces) {
-                                    if(depth == 1) {
-                                        totalNodes++;
-                                    } else {
-                                        // For recursion, create new engine and make the move
-                                        std::string currentFen = m_fen.getFen();
-                                        ChessEngine recursiveEngine{FENString(currentFen)};
-                                    
-                                        Game_Status moveResult = recursiveEngine.isValidMove(move, promotionPiece);
-                                        if(moveResult != Game_Status::INVALID) {
-                                            totalNodes += recursiveEngine._perftSingleThreaded(depth - 1);
-                                        }
-                                    }
-                                }
-                            } else {
-                                if(depth == 1) {
-                                    totalNodes++;
-                                } else {
-                                    // For recursion, create new engine and make the move
-                                    std::string currentFen = m_fen.getFen();
-                                    ChessEngine recursiveEngine{FENString(currentFen)};
-                                
-                                    Game_Status moveResult = recursiveEngine.isValidMove(move);
-                                    if(moveResult != Game_Status::INVALID) {
-                                        totalNodes += recursiveEngine._perftSingleThreaded(depth - 1);
-                                    }
-                                }
-                            }
-                        }
-                    } catch (const std::exception& e) {            
-                        continue;
-                    }
-                }
-            }
+    if (!m_perftPool || m_perftPool->size() != threads) {
+        m_perftPool = std::make_unique<WorkStealingPool>(threads);
+    }
+    return *m_perftPool;
+}
+
+// A table that cannot be allocated is halved until one fits, or perft runs without one.
+PerftHash* ChessEngine::_perftHash() {
+    if (m_perftHashMegabytes == 0) {
+        m_perftHash.reset();
+        return nullptr;
+    }
+
+    for (size_t megabytes = m_perftHashMegabytes; !m_perftHash && megabytes > 0; megabytes /= 2) {
+        try {
+            m_perftHash = std::make_unique<PerftHash>(megabytes);
+        } catch (const std::bad_alloc&) {
+            continue;
+        }
+        if (megabytes != m_perftHashMegabytes) {
+            _printInfo("perft hash of " + std::to_string(m_perftHashMegabytes) + " MB could not be allocated, using "
+                       + std::to_string(megabytes) + " MB");
         }
     }
-    return totalNodes;
+    if (!m_perftHash) {
+        _printInfo("perft hash of " + std::to_string(m_perftHashMegabytes) + " MB could not be allocated, running without it");
+        m_perftHashMegabytes = 0;
+    }
+    return m_perftHash.get();
+}
+
+// Does the recursive function for the thread.
+std::uint64_t ChessEngine::_perftSingleThreaded(unsigned int depth) {
+    PerftHash::Stats stats;
+    return perftRecursive(*m_board, depth, m_perftBulkCounting, _perftHash(), stats);
 }
 
 std::string ChessEngine::getFenStr() const{
-    return m_fen.getFen();
+    return m_board->getFenStr();
 }
\ No newline at end of file
@@ -187,14 +187,12 @@ size_t FENString::__isValidTotalMove(std::string& fen, unsigned int& totalMoves)
     size_t val = fen.find(m_spaceDelim, m_lastDelim + 1);
     std::string totalMoveData = fen.substr(val + 1);
     size_t num{0};
-    size_t digitPlaceShift{1};
     for(char digit : totalMoveData){
         if(!isdigit(digit)){
             return std::string::npos;
         }
-        num *= digitPlaceShift;
+        num *= 10;
         num += digit - '0';
-        digitPlaceShift *= 10;
     } 
     totalMoves = num;
     return val;
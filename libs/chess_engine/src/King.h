@@ -5,22 +5,11 @@
 class King final : public Piece {
 
     public:
-        King(Piece_T pieceType, Color_T pieceColor, const Square& pieceSquareRef, const Board& pieceBoardRef); // Same as base but need to set has moved.
+        King(Piece_T pieceType, Color_T pieceColor, const Square& pieceSquareRef, const Board& pieceBoardRef);
 
-        void setHasMoved(bool);
+        // Read from the board's castling rights. Only castling cares whether a king has moved,
+        // so a king with no rights left counts as moved.
         bool getHasMoved() const;
-
         bool getCanCastleShort() const;
-        void setCanCastleShort(bool);
-
         bool getCanCastleLong() const;
-        void setCanCastleLong(bool);
-
-        virtual bool isValidMove(const Square& otherSquare) const override;
-        virtual void updateAttacking() override;
-
-    private:
-        bool hasMoved;
-        bool m_canCastleShort;
-        bool m_canCastleLong;
 };
\ No newline at end of file
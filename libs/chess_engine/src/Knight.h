@@ -5,8 +5,5 @@
 class Knight final : public Piece {
 
     public:
-        Knight(Piece_T pieceType, Color_T pieceColor, const Square& pieceSquareRef, const Board& pieceBoardRef); // Same as base but need to set has moved.
-
-        virtual bool isValidMove(const Square& otherSquare) const override;
-        virtual void updateAttacking() override;
+        Knight(Piece_T pieceType, Color_T pieceColor, const Square& pieceSquareRef, const Board& pieceBoardRef);
 };
\ No newline at end of file
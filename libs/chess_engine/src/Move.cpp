@@ -0,0 +1,48 @@
+#include "chess_engine/Move.h"
+
+static constexpr char PROMOTION_CHARS[]{'n', 'b', 'r', 'q'}; // KNIGHT..QUEEN
+
+std::string Move::toUci() const {
+    if(isNone()) {
+        return "0000";
+    }
+
+    std::string uci{
+        static_cast<char>('a' + from() % MAX_COLS), static_cast<char>('8' - from() / MAX_COLS),
+        static_cast<char>('a' + to() % MAX_COLS), static_cast<char>('8' - to() / MAX_COLS)
+    };
+    if(isPromotion()) {
+        uci += PROMOTION_CHARS[static_cast<size_t>(promotion()) - static_cast<size_t>(Piece_T::KNIGHT)];
+    }
+    return uci;
+}
+
+Move Move::fromUci(std::string_view uci) {
+    if(uci.length() != 4 && uci.length() != 5) {
+        return none();
+    }
+
+    char fromFile = uci[0];
+    char fromRank = uci[1];
+    char toFile = uci[2];
+    char toRank = uci[3];
+    if (fromFile < 'a' || fromFile > 'h' || toFile < 'a' || toFile > 'h' ||
+        fromRank < '1' || fromRank > '8' || toRank < '1' || toRank > '8') {
+        return none();
+    }
+
+    // Row 0 is rank 8.
+    size_t from = static_cast<size_t>('8' - fromRank) * MAX_COLS + static_cast<size_t>(fromFile - 'a');
+    size_t to = static_cast<size_t>('8' - toRank) * MAX_COLS + static_cast<size_t>(toFile - 'a');
+
+    if(uci.length() == 5) {
+        switch(uci[4]) {
+            case 'q': return Move{from, to, Flag_T::PROMOTION, Piece_T::QUEEN};
+            case 'r': return Move{from, to, Flag_T::PROMOTION, Piece_T::ROOK};
+            case 'b': return Move{from, to, Flag_T::PROMOTION, Piece_T::BISHOP};
+            case 'n': return Move{from, to, Flag_T::PROMOTION, Piece_T::KNIGHT};
+            default: return none();
+        }
+    }
+    return Move{from, to};
+}
\ No newline at end of file
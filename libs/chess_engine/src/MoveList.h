@@ -0,0 +1,34 @@
+#pragma once
+#include "chess_engine/Move.h"
+#include <array>
+
+// Which subset of moves a generator call produces.
+// CAPTURES and QUIETS are legal moves split on whether something is taken (en passant counts as a capture).
+enum class GenMode_T : unsigned int { LEGAL, PSEUDO_LEGAL, CAPTURES, QUIETS };
+
+/*
+    Fixed-capacity move list meant to live on the stack.
+    No position has more than 218 legal moves, so 256 leaves room for pseudo-legal lists too.
+    Promotions are listed once per promotion piece.
+*/
+class MoveList final {
+    public:
+        static constexpr size_t CAPACITY{256};
+
+        void add(Move move) { m_moves[m_size++] = move; }
+
+        void clear() { m_size = 0; }
+
+        size_t size() const { return m_size; }
+        bool empty() const { return m_size == 0; }
+
+        Move& operator[](size_t index) { return m_moves[index]; }
+        const Move& operator[](size_t index) const { return m_moves[index]; }
+
+        const Move* begin() const { return m_moves.data(); }
+        const Move* end() const { return m_moves.data() + m_size; }
+
+    private:
+        std::array<Move, CAPACITY> m_moves;
+        size_t m_size{0};
+};
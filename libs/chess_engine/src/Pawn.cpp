@@ -6,39 +6,21 @@
 #include <iostream>
 
 Pawn::Pawn(Piece_T pieceType, Color_T pieceColor, const Square& pieceSquareRef, const Board& pieceBoardRef)
-    : Piece(pieceType, pieceColor, pieceSquareRef, pieceBoardRef) {
-        setHasMoved(false);
-        setEnPassantCaptureStatus(false);
-    }
+    : Piece(pieceType, pieceColor, pieceSquareRef, pieceBoardRef) {}
 
-void Pawn::setHasMoved(bool newHasMoved){
-    hasMoved = newHasMoved;
+// Pawns never move backwards, so one still on its starting rank has not moved.
+bool Pawn::getHasMoved() const {
+    return getSquarePosition().getRow() != (getColor() == Color_T::WHITE ? MAX_ROWS - 2 : 1);
 }
 
-bool Pawn::getHasMoved() const { return hasMoved; }
-
-void Pawn::setEnPassantCaptureStatus(bool newEnPassantCaptureStatus) {
-    enPassantCaptureStatus = newEnPassantCaptureStatus;
-}
-bool Pawn::getEnPassantCaptureStatus() const { return enPassantCaptureStatus; }
-
-bool Pawn::isValidMove(const Square& toSquare) const {
-    return getBoard().validPawnMove(getSquarePosition(), toSquare, getColor(), getHasMoved());
-} 
-
-void Pawn::updateAttacking() {
-    _clearAttacking();
-    for(size_t row = 0; row < MAX_ROWS; ++row) {
-        for(size_t col = 0; col < MAX_COLS; ++col) {
-            const Square& to = getBoard().getBoardAt(row, col);
-            if(to.isOccupied()){
-                if(isValidMove(to)){
-                    const Piece* attackedPiece = getBoard().getPieceAt(row, col);
-                    addToAttacking(attackedPiece);
-                }
-            }
-        }
+bool Pawn::getEnPassantCaptureStatus() const {
+    size_t epSquare = getBoard().getEnPassantSquare();
+    if(epSquare == NO_SQUARE) {
+        return false;
     }
+    // The target is the square the pawn skipped, one row behind it.
+    size_t behindRow = getColor() == Color_T::WHITE ? getSquarePosition().getRow() + 1 : getSquarePosition().getRow() - 1;
+    return epSquare == makeSquare(behindRow, getSquarePosition().getCol());
 }
 
 std::string Pawn::toString() const {
@@ -6,19 +6,11 @@
 class Pawn final : public Piece {
 
     public:
-        Pawn(Piece_T pieceType, Color_T pieceColor, const Square& pieceSquareRef, const Board& pieceBoardRef); // Same as base but need to set has moved.
+        Pawn(Piece_T pieceType, Color_T pieceColor, const Square& pieceSquareRef, const Board& pieceBoardRef);
 
-        void setHasMoved(bool);
+        // Both are read from the board's position state rather than stored on the pawn.
         bool getHasMoved() const;
+        bool getEnPassantCaptureStatus() const; // True right after this pawn's double push.
 
-        void setEnPassantCaptureStatus(bool);
-        bool getEnPassantCaptureStatus() const;
-
-        virtual bool isValidMove(const Square& otherSquare) const override;
-        virtual void updateAttacking() override;
         virtual std::string toString() const override;
-
-    private:
-        bool enPassantCaptureStatus; // Is set to true after moving 2 and then upon another move set back to false;
-        bool hasMoved;
 };
\ No newline at end of file
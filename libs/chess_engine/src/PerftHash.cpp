@@ -0,0 +1,49 @@
+#include "PerftHash.h"
+#include <algorithm>
+#include <bit>
+
+PerftHash::PerftHash(size_t megabytes) {
+    size_t entries = std::bit_floor((std::min(megabytes, MAX_MEGABYTES) << 20) / sizeof(Entry));
+    if(entries == 0) { entries = 1; }
+    m_entries = std::make_unique<Entry[]>(entries);
+    m_mask = entries - 1;
+}
+
+size_t PerftHash::megabytes() const {
+    return ((m_mask + 1) * sizeof(Entry)) >> 20;
+}
+
+bool PerftHash::probe(Zobrist::Key key, unsigned int depth, std::uint64_t& nodes) const {
+    Zobrist::Key hashKey = _hashKey(key, depth);
+    const Entry& entry = m_entries[hashKey & m_mask];
+    std::uint64_t data = entry.data.load(std::memory_order_relaxed);
+    std::uint64_t check = entry.check.load(std::memory_order_relaxed);
+    if((check ^ data) != hashKey || (data & DEPTH_MASK) != depth) {
+        return false;
+    }
+    nodes = data >> DEPTH_BITS;
+    return true;
+}
+
+// Always replaces, the newest subtree is the one most likely to be met again.
+void PerftHash::store(Zobrist::Key key, unsigned int depth, std::uint64_t nodes) {
+    Zobrist::Key hashKey = _hashKey(key, depth);
+    Entry& entry = m_entries[hashKey & m_mask];
+    std::uint64_t data = (nodes << DEPTH_BITS) | (depth & DEPTH_MASK);
+    entry.check.store(hashKey ^ data, std::memory_order_relaxed);
+    entry.data.store(data, std::memory_order_relaxed);
+}
+
+void PerftHash::addStats(const Stats& stats) {
+    m_probes.fetch_add(stats.probes, std::memory_order_relaxed);
+    m_hits.fetch_add(stats.hits, std::memory_order_relaxed);
+}
+
+PerftHash::Stats PerftHash::stats() const {
+    return Stats{m_probes.load(std::memory_order_relaxed), m_hits.load(std::memory_order_relaxed)};
+}
+
+void PerftHash::resetStats() {
+    m_probes.store(0, std::memory_order_relaxed);
+    m_hits.store(0, std::memory_order_relaxed);
+}
\ No newline at end of file
@@ -0,0 +1,52 @@
+#pragma once
+#include "Zobrist.h"
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+/*
+    Node counts of already searched subtrees, keyed by position key and remaining depth.
+    Shared by every perft worker without locks. Each entry is two 64 bit words: the packed count and
+    depth, and that word XORed with the key. A torn write from two threads storing at once leaves a
+    pair that fails the XOR check, so it reads as a miss rather than as a wrong count.
+*/
+class PerftHash final {
+    public:
+        // Probes counted by one worker and added in one go, so lookups never share a counter.
+        struct Stats {
+            std::uint64_t probes{0};
+            std::uint64_t hits{0};
+        };
+
+        static constexpr size_t MAX_MEGABYTES{16384};
+
+        // Clamped to MAX_MEGABYTES and rounded down to a power of two number of entries.
+        // Throws std::bad_alloc when the table cannot be allocated.
+        explicit PerftHash(size_t megabytes);
+
+        size_t megabytes() const;
+
+        bool probe(Zobrist::Key key, unsigned int depth, std::uint64_t& nodes) const;
+        void store(Zobrist::Key key, unsigned int depth, std::uint64_t nodes);
+
+        void addStats(const Stats& stats);
+        Stats stats() const;
+        void resetStats(); // Entries stay valid between runs, only the counters start over.
+
+    private:
+        struct Entry {
+            std::atomic<std::uint64_t> check{0}; // key ^ data
+            std::atomic<std::uint64_t> data{0};  // nodes << DEPTH_BITS | depth
+        };
+
+        static constexpr unsigned int DEPTH_BITS{8};
+        static constexpr std::uint64_t DEPTH_MASK{(1ULL << DEPTH_BITS) - 1};
+
+        std::unique_ptr<Entry[]> m_entries;
+        size_t m_mask{0};
+        std::atomic<std::uint64_t> m_probes{0};
+        std::atomic<std::uint64_t> m_hits{0};
+
+        // The same position at another depth is a different entry, and usually lands in another slot.
+        static Zobrist::Key _hashKey(Zobrist::Key key, unsigned int depth) { return key ^ (depth * 0x9E3779B97F4A7C15ULL); }
+};
\ No newline at end of file
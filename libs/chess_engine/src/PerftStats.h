@@ -0,0 +1,32 @@
+#pragma once
+#include <cstdint>
+
+/*
+    Leaf move counts in the categories of the standard perft tables. Everything is counted for the
+    moves made at the last ply only. En passant captures count as captures too. As in the published
+    tables a double check is only counted as a double check, never as a discovered one.
+*/
+struct PerftStats {
+    std::uint64_t nodes{0};
+    std::uint64_t captures{0};
+    std::uint64_t enPassant{0};
+    std::uint64_t castles{0};
+    std::uint64_t promotions{0};
+    std::uint64_t checks{0};
+    std::uint64_t discoveredChecks{0};
+    std::uint64_t doubleChecks{0};
+    std::uint64_t checkmates{0};
+
+    PerftStats& operator+=(const PerftStats& other) {
+        nodes += other.nodes;
+        captures += other.captures;
+        enPassant += other.enPassant;
+        castles += other.castles;
+        promotions += other.promotions;
+        checks += other.checks;
+        discoveredChecks += other.discoveredChecks;
+        doubleChecks += other.doubleChecks;
+        checkmates += other.checkmates;
+        return *this;
+    }
+};
\ No newline at end of file
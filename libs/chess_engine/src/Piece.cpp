@@ -1,10 +1,11 @@
 #include "Piece.h"
+#include "Board.h"
 #include "chess_engine/ColorUtil.h"
 #include <stdexcept>
 #include <sstream>
 
 Piece::Piece(Piece_T pieceType, Color_T pieceColor, const Square& pieceSquareRef, const Board& pieceBoardRef)
-    : type{pieceType}, color{pieceColor}, positionRef{&pieceSquareRef}, boardRef{pieceBoardRef}, attacking{} {
+    : type{pieceType}, color{pieceColor}, positionRef{&pieceSquareRef}, boardRef{pieceBoardRef} {
         
         if(pieceSquareRef.isOccupied()){
             throw std::invalid_argument("Error: A piece cannot be initialized where another piece already exists.");
@@ -40,23 +41,6 @@ std::string Piece::typeToString(Piece_T type) {
     }
 }
 
-void Piece::addToAttacking(const Piece* pieceToAdd) {
-    attacking.push_back(pieceToAdd);
-}
-void Piece::deleteFromAttacking(size_t indexToErase) {
-     attacking.erase(attacking.begin() + indexToErase);
-}
-
-const std::vector<const Piece*>& Piece::getAttacking() const{
-    return attacking;
-}
-
-void Piece::_clearAttacking(){
-    if(!attacking.empty()){
-        attacking.clear();
-    }
-}
-
 const Board& Piece::getBoard() const {
     return boardRef;
 }
@@ -73,6 +57,11 @@ unsigned int Piece::getValue() const {
     return static_cast<unsigned int>(type);
 }
 
+bool Piece::isValidMove(const Square& toSquare) const {
+    return boardRef.isValidPattern(makeSquare(positionRef->getRow(), positionRef->getCol()),
+                                   makeSquare(toSquare.getRow(), toSquare.getCol()));
+}
+
 std::string Piece::toString() const {
     std::ostringstream output;
     output << "Piece: " << Piece::typeToString(getType());
@@ -7,7 +7,7 @@
 
 class Board;
 
-// abstract class - not an initializable object.
+// Base of the object facade over the board. Only toString differs between piece types.
 class Piece {
     public:
         Piece(Piece_T pieceType, Color_T pieceColor, const Square& pieceSquareRef, const Board& pieceBoardRef);
@@ -19,11 +19,6 @@ class Piece {
         Color_T getColor() const;
         void setColor(Color_T);
 
-        const std::vector<const Piece*>& getAttacking() const;
-
-        void addToAttacking(const Piece*);
-        void deleteFromAttacking(size_t indexToErase);
-
         static std::string typeToString(Piece_T type);
     
         const Board& getBoard() const;
@@ -33,17 +28,12 @@ class Piece {
 
         unsigned int getValue() const; // return enum class value for the piece type.
 
-        virtual bool isValidMove(const Square& toSquare) const = 0; // pure virtual. Based on derived class implementation.
-        virtual void updateAttacking() = 0;
+        bool isValidMove(const Square& toSquare) const; // Dispatched by the board on the piece code, not by a virtual call.
         virtual std::string toString() const; // Interpret the Piece_T in their own implementation.
 
-        void _clearAttacking();
-
     private:
         Piece_T type;
         Color_T color;
         const Square* positionRef;
         const Board& boardRef;
-
-        std::vector<const Piece*> attacking;
 };
\ No newline at end of file
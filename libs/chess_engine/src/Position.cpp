@@ -0,0 +1,62 @@
+#include "Position.h"
+#include "Attacks.h"
+
+PieceCode Position::pieceOn(size_t sq) const { return m_mailbox[sq]; }
+bool Position::isEmpty(size_t sq) const { return m_mailbox[sq] == NO_PIECE; }
+
+Bitboard Position::pieces(Color_T color) const { return m_colorBB[colorIndex(color)]; }
+Bitboard Position::pieces(Color_T color, Piece_T type) const { return m_pieceBB[makePieceCode(color, type)]; }
+Bitboard Position::pieces(Piece_T type) const {
+    return pieces(Color_T::WHITE, type) | pieces(Color_T::BLACK, type);
+}
+Bitboard Position::occupied() const { return m_occupiedBB; }
+
+size_t Position::kingSquare(Color_T color) const {
+    return lsb(pieces(color, Piece_T::KING));
+}
+
+Position::Material Position::material() const { return m_material; }
+
+void Position::removePiece(size_t sq) {
+    PieceCode code = m_mailbox[sq];
+    if(code == NO_PIECE) { return; }
+    Bitboard bb = squareBB(sq);
+
+    m_mailbox[sq] = NO_PIECE;
+    m_pieceBB[code] ^= bb;
+    m_colorBB[colorIndex(pieceCodeColor(code))] ^= bb;
+    m_occupiedBB ^= bb;
+    m_material -= materialOf(code);
+}
+
+void Position::movePiece(size_t from, size_t to) {
+    PieceCode code = m_mailbox[from];
+    Bitboard fromTo = squareBB(from) | squareBB(to);
+
+    m_mailbox[to] = code;
+    m_mailbox[from] = NO_PIECE;
+    m_pieceBB[code] ^= fromTo;
+    m_colorBB[colorIndex(pieceCodeColor(code))] ^= fromTo;
+    m_occupiedBB ^= fromTo;
+}
+
+Bitboard Position::attackersTo(size_t sq, Bitboard occupied) const {
+    Bitboard rookLike = pieces(Piece_T::ROOK) | pieces(Piece_T::QUEEN);
+    Bitboard bishopLike = pieces(Piece_T::BISHOP) | pieces(Piece_T::QUEEN);
+
+    // A pawn of one color attacks sq exactly when a pawn of the other color on sq would attack it back.
+    return (Attacks::pawn(Color_T::BLACK, sq) & pieces(Color_T::WHITE, Piece_T::PAWN))
+         | (Attacks::pawn(Color_T::WHITE, sq) & pieces(Color_T::BLACK, Piece_T::PAWN))
+         | (Attacks::knight(sq) & pieces(Piece_T::KNIGHT))
+         | (Attacks::king(sq) & pieces(Piece_T::KING))
+         | (Attacks::rook(sq, occupied) & rookLike)
+         | (Attacks::bishop(sq, occupied) & bishopLike);
+}
+
+bool Position::isSquareAttacked(size_t sq, Color_T byColor) const {
+    return isSquareAttacked(sq, byColor, m_occupiedBB);
+}
+
+bool Position::isSquareAttacked(size_t sq, Color_T byColor, Bitboard occupied) const {
+    return (attackersTo(sq, occupied) & pieces(byColor)) != EMPTY_BB;
+}
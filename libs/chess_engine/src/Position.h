@@ -0,0 +1,88 @@
+#pragma once
+#include "Bitboard.h"
+#include "Attacks.h"
+#include "chess_engine/ColorUtil.h"
+#include <array>
+#include <cstdint>
+
+/*
+    Bitboard representation of piece placement.
+    One bitboard per piece code (color + type), per-color occupancy, total occupancy,
+    and a mailbox so the piece on a square can be read without scanning the bitboards.
+*/
+class Position final {
+    public:
+        // Piece counts packed 4 bits per piece code. Two positions with the same material have the same
+        // signature, so material classes (e.g. insufficient material) can be recognised by value.
+        using Material = std::uint64_t;
+        static constexpr Material materialOf(PieceCode code) { return Material{1} << (4 * code); }
+
+        constexpr Position() { clear(); }
+
+        constexpr void clear();
+
+        PieceCode pieceOn(size_t sq) const;
+        bool isEmpty(size_t sq) const;
+
+        Bitboard pieces(Color_T color) const;
+        Bitboard pieces(Color_T color, Piece_T type) const;
+        Bitboard pieces(Piece_T type) const; // Both colors.
+        Bitboard occupied() const;
+
+        size_t kingSquare(Color_T color) const; // NO_SQUARE if that side has no king.
+        Material material() const;
+
+        constexpr void putPiece(size_t sq, Color_T color, Piece_T type);
+        void removePiece(size_t sq);
+        void movePiece(size_t from, size_t to); // to must be empty.
+
+        // Every piece of either color attacking sq, given the occupancy used to block sliders.
+        Bitboard attackersTo(size_t sq, Bitboard occupied) const;
+        bool isSquareAttacked(size_t sq, Color_T byColor) const;
+        bool isSquareAttacked(size_t sq, Color_T byColor, Bitboard occupied) const;
+
+        // Pieces of color By attacking sq. With the color fixed at compile time the pawn direction
+        // is a constant and only By's bitboards are read.
+        template<Color_T By>
+        Bitboard attackersBy(size_t sq, Bitboard occupied) const;
+
+    private:
+        std::array<Bitboard, NUM_PIECE_CODES> m_pieceBB{};
+        std::array<Bitboard, 2> m_colorBB{};
+        Bitboard m_occupiedBB{EMPTY_BB};
+        std::array<PieceCode, NUM_SQUARES> m_mailbox{};
+        Material m_material{0};
+};
+
+// Both are constexpr so whole positions, such as the start position, can be built at compile time.
+constexpr void Position::clear() {
+    m_pieceBB.fill(EMPTY_BB);
+    m_colorBB.fill(EMPTY_BB);
+    m_occupiedBB = EMPTY_BB;
+    m_mailbox.fill(NO_PIECE);
+    m_material = 0;
+}
+
+constexpr void Position::putPiece(size_t sq, Color_T color, Piece_T type) {
+    PieceCode code = makePieceCode(color, type);
+    Bitboard bb = squareBB(sq);
+
+    m_mailbox[sq] = code;
+    m_pieceBB[code] |= bb;
+    m_colorBB[colorIndex(color)] |= bb;
+    m_occupiedBB |= bb;
+    m_material += materialOf(code);
+}
+
+template<Color_T By>
+Bitboard Position::attackersBy(size_t sq, Bitboard occupied) const {
+    constexpr Color_T Them = oppositeColor(By);
+    const Bitboard queens = pieces(By, Piece_T::QUEEN);
+
+    // A pawn of By attacks sq exactly when a pawn of the other color on sq would attack it back.
+    return (Attacks::pawn(Them, sq) & pieces(By, Piece_T::PAWN))
+         | (Attacks::knight(sq) & pieces(By, Piece_T::KNIGHT))
+         | (Attacks::king(sq) & pieces(By, Piece_T::KING))
+         | (Attacks::rook(sq, occupied) & (pieces(By, Piece_T::ROOK) | queens))
+         | (Attacks::bishop(sq, occupied) & (pieces(By, Piece_T::BISHOP) | queens));
+}
\ No newline at end of file
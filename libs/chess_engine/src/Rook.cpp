@@ -3,8 +3,6 @@
 
 Rook::Rook(Piece_T pieceType, Color_T pieceColor, const Square& pieceSquareRef, const Board& pieceBoardRef)
     : Piece(pieceType, pieceColor, pieceSquareRef, pieceBoardRef) {
-        setHasMoved(false);
-        
         if(pieceSquareRef.getCol() == MAX_COLS - 1) { // If its a short sided rook
             setRookShort(true);
             setRookLong(false);
@@ -14,34 +12,15 @@ Rook::Rook(Piece_T pieceType, Color_T pieceColor, const Square& pieceSquareRef,
         }
     }
 
-void Rook::setHasMoved(bool newHasMoved){
-    hasMoved = newHasMoved;
+bool Rook::getHasMoved() const {
+    Board::Castle_T side = getColor() == Color_T::WHITE
+        ? (getRookShort() ? Board::Castle_T::WHITE_SHORT : Board::Castle_T::WHITE_LONG)
+        : (getRookShort() ? Board::Castle_T::BLACK_SHORT : Board::Castle_T::BLACK_LONG);
+    return !getBoard().hasCastleRight(side);
 }
 
-void Rook::updateAttacking() {
-    _clearAttacking();
-    for(size_t row = 0; row < MAX_ROWS; ++row) {
-        for(size_t col = 0; col < MAX_COLS; ++col) {
-            const Square& to = getBoard().getBoardAt(row, col);
-            if(to.isOccupied()){
-                const Piece* attackedPiece = getBoard().getPieceAt(row, col);
-                if(isValidMove(to)){
-                    addToAttacking(attackedPiece);
-                }
-            }
-        }
-    }
-}
-
-bool Rook::getHasMoved() const { return hasMoved; }
-
 bool Rook::getRookLong() const { return rookLong;}
 void Rook::setRookLong(bool newRookLong) { rookLong = newRookLong; }
 
 bool Rook::getRookShort() const { return rookShort; }
-void Rook::setRookShort(bool newRookShort) { rookShort = newRookShort; }
-
-
-bool Rook::isValidMove(const Square& toSquare) const {
-    return getBoard().validRookMove(getSquarePosition(), toSquare, getColor());
-} 
\ No newline at end of file
+void Rook::setRookShort(bool newRookShort) { rookShort = newRookShort; }
\ No newline at end of file
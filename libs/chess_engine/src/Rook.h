@@ -5,9 +5,9 @@
 class Rook final : public Piece {
 
     public:
-        Rook(Piece_T pieceType, Color_T pieceColor, const Square& pieceSquareRef, const Board& pieceBoardRef); // Same as base but need to set has moved.
+        Rook(Piece_T pieceType, Color_T pieceColor, const Square& pieceSquareRef, const Board& pieceBoardRef);
 
-        void setHasMoved(bool);
+        // Read from the board's castling rights, a rook that can no longer castle counts as moved.
         bool getHasMoved() const;
 
         bool getRookLong() const;
@@ -16,11 +16,7 @@ class Rook final : public Piece {
         bool getRookShort() const;
         void setRookShort(bool);
 
-        virtual bool isValidMove(const Square& otherSquare) const override;
-        virtual void updateAttacking() override;
-    
     private:
-        bool hasMoved;
         bool rookShort;
         bool rookLong;
 };
\ No newline at end of file
@@ -0,0 +1,116 @@
+#include "WorkStealingPool.h"
+
+namespace {
+    // Which pool and deque the current thread works for, so submit() from inside a task stays local.
+    thread_local const WorkStealingPool* s_currentPool{nullptr};
+    thread_local size_t s_currentWorker{0};
+}
+
+WorkStealingPool::WorkStealingPool(unsigned int threads) {
+    if(threads == 0) { threads = 1; }
+    m_workers.reserve(threads);
+    for(unsigned int i = 0; i < threads; ++i) {
+        m_workers.push_back(std::make_unique<Worker>());
+    }
+    m_threads.reserve(threads);
+    try {
+        for(size_t i = 0; i < threads; ++i) {
+            m_threads.emplace_back(&WorkStealingPool::_run, this, i);
+        }
+    } catch(...) {
+        // The destructor does not run for a half built pool, and a joinable thread left behind terminates.
+        _stop();
+        throw;
+    }
+}
+
+WorkStealingPool::~WorkStealingPool() {
+    _stop();
+}
+
+unsigned int WorkStealingPool::size() const {
+    return static_cast<unsigned int>(m_workers.size());
+}
+
+void WorkStealingPool::submit(Task task) {
+    size_t target = s_currentPool == this ? s_currentWorker
+                                          : m_nextWorker.fetch_add(1, std::memory_order_relaxed) % m_workers.size();
+    m_pending.fetch_add(1, std::memory_order_relaxed);
+    {
+        std::lock_guard<std::mutex> lock(m_workers[target]->mutex);
+        m_workers[target]->tasks.push_back(std::move(task));
+        m_queued.fetch_add(1, std::memory_order_release);
+    }
+
+    // Sleepers check m_queued under this mutex, so taking it here means the wake up cannot be missed.
+    std::lock_guard<std::mutex> lock(m_sleepMutex);
+    if(m_sleeping > 0) { m_workAvailable.notify_one(); }
+}
+
+void WorkStealingPool::wait() {
+    std::unique_lock<std::mutex> lock(m_sleepMutex);
+    m_allDone.wait(lock, [this] { return m_pending.load(std::memory_order_acquire) == 0; });
+}
+
+size_t WorkStealingPool::currentWorker() const {
+    return s_currentPool == this ? s_currentWorker : 0;
+}
+
+bool WorkStealingPool::_pop(size_t self, Task& task) {
+    Worker& worker = *m_workers[self];
+    std::lock_guard<std::mutex> lock(worker.mutex);
+    if(worker.tasks.empty()) { return false; }
+    task = std::move(worker.tasks.back());
+    worker.tasks.pop_back();
+    m_queued.fetch_sub(1, std::memory_order_relaxed);
+    return true;
+}
+
+bool WorkStealingPool::_steal(size_t self, Task& task) {
+    for(size_t offset = 1; offset < m_workers.size(); ++offset) {
+        Worker& victim = *m_workers[(self + offset) % m_workers.size()];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if(!victim.tasks.empty()) {
+            task = std::move(victim.tasks.front());
+            victim.tasks.pop_front();
+            m_queued.fetch_sub(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+    return false;
+}
+
+void WorkStealingPool::_run(size_t self) {
+    s_currentPool = this;
+    s_currentWorker = self;
+
+    Task task;
+    while(true) {
+        if(_pop(self, task) || _steal(self, task)) {
+            task();
+            task = nullptr;
+            if(m_pending.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                std::lock_guard<std::mutex> lock(m_sleepMutex);
+                m_allDone.notify_all();
+            }
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(m_sleepMutex);
+        ++m_sleeping;
+        m_workAvailable.wait(lock, [this] { return m_stopping || m_queued.load(std::memory_order_acquire) > 0; });
+        --m_sleeping;
+        if(m_stopping) { return; }
+    }
+}
+
+void WorkStealingPool::_stop() {
+    {
+        std::lock_guard<std::mutex> lock(m_sleepMutex);
+        m_stopping = true;
+    }
+    m_workAvailable.notify_all();
+    for(std::thread& thread : m_threads) {
+        thread.join();
+    }
+}
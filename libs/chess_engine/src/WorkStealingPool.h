@@ -0,0 +1,62 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/*
+    Fixed set of worker threads that live as long as the pool. Every worker owns a deque: it pushes
+    and pops its own tasks at the back (newest first, so a split subtree stays in cache) and, once
+    that runs dry, steals the oldest task from the front of another worker's deque. Old tasks sit
+    nearest the root, so a steal takes a big piece of work and steals stay rare.
+    Tasks may submit more tasks; wait() returns once every task, including those, has finished.
+*/
+class WorkStealingPool final {
+    public:
+        using Task = std::function<void()>;
+
+        explicit WorkStealingPool(unsigned int threads);
+        ~WorkStealingPool();
+
+        WorkStealingPool(const WorkStealingPool&) = delete;
+        WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+        unsigned int size() const;
+
+        // From a worker the task goes onto that worker's own deque, otherwise the deques take turns.
+        void submit(Task task);
+        void wait();
+
+        // Index of the worker running the calling task, so tasks can keep per-worker results that no
+        // other thread writes. Only meaningful from inside a task.
+        size_t currentWorker() const;
+
+    private:
+        struct Worker {
+            std::mutex mutex;
+            std::deque<Task> tasks;
+        };
+
+        std::vector<std::unique_ptr<Worker>> m_workers;
+        std::vector<std::thread> m_threads;
+
+        std::atomic<size_t> m_pending{0}; // Submitted and not yet finished.
+        std::atomic<size_t> m_queued{0};  // Sitting in a deque.
+        std::atomic<size_t> m_nextWorker{0};
+
+        std::mutex m_sleepMutex;
+        std::condition_variable m_workAvailable;
+        std::condition_variable m_allDone;
+        size_t m_sleeping{0};
+        bool m_stopping{false};
+
+        bool _pop(size_t self, Task& task);
+        bool _steal(size_t self, Task& task);
+        void _run(size_t self);
+        void _stop(); // Wakes every worker and joins them.
+};
\ No newline at end of file
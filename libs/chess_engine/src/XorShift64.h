@@ -0,0 +1,24 @@
+#pragma once
+#include <cstdint>
+
+/*
+    xorshift64* generator. Shared by the Zobrist keys, the magic search and the benchmarks, which all
+    want a fixed seed so every run produces the same numbers. constexpr so keys can be built at compile time.
+*/
+class XorShift64 final {
+    public:
+        constexpr explicit XorShift64(std::uint64_t seed) : m_state{seed} {}
+
+        constexpr std::uint64_t next() {
+            m_state ^= m_state >> 12;
+            m_state ^= m_state << 25;
+            m_state ^= m_state >> 27;
+            return m_state * 2685821657736338717ULL;
+        }
+
+        // Few set bits, magic candidates like this are found much faster.
+        constexpr std::uint64_t sparse() { return next() & next() & next(); }
+
+    private:
+        std::uint64_t m_state;
+};
\ No newline at end of file
@@ -0,0 +1,54 @@
+#pragma once
+#include "Bitboard.h"
+#include "XorShift64.h"
+#include <array>
+#include <cstdint>
+
+/*
+    Random keys for Zobrist hashing. A position's key is the XOR of one key per (piece code, square),
+    one per castling rights mask, one for the en passant file and one more when black is to move.
+    Keys are generated at compile time from a fixed seed, so they are identical in every build and run.
+*/
+class Zobrist final {
+    public:
+        using Key = std::uint64_t;
+
+        // Castling rights packed into 4 bits (BoardState::castling), the index for castling().
+        static constexpr size_t NUM_CASTLE_MASKS{16};
+
+        static Key piece(PieceCode code, size_t sq) { return s_keys.pieces[code][sq]; }
+        static Key castling(unsigned int mask) { return s_keys.castling[mask]; }
+        static Key enPassant(size_t col) { return s_keys.enPassant[col]; }
+        static Key blackToMove() { return s_keys.blackToMove; }
+
+    private:
+        struct Keys {
+            std::array<std::array<Key, NUM_SQUARES>, NUM_PIECE_CODES> pieces{};
+            std::array<Key, NUM_CASTLE_MASKS> castling{};
+            std::array<Key, MAX_COLS> enPassant{};
+            Key blackToMove{0};
+        };
+
+        static constexpr Keys _generate() {
+            Keys keys{};
+            XorShift64 random{0x9E3779B97F4A7C15ULL};
+            for(auto& square : keys.pieces) {
+                for(Key& key : square) {
+                    key = random.next();
+                }
+            }
+            // The empty mask keeps key 0 so a position without rights hashes like one that never had any.
+            for(size_t mask = 1; mask < NUM_CASTLE_MASKS; ++mask) {
+                keys.castling[mask] = random.next();
+            }
+            for(Key& key : keys.enPassant) {
+                key = random.next();
+            }
+            keys.blackToMove = random.next();
+            return keys;
+        }
+
+        static const Keys s_keys;
+};
+
+inline constexpr Zobrist::Keys Zobrist::s_keys{Zobrist::_generate()};
@@ -0,0 +1,9 @@
+#pragma once
+#include <iostream>
+#include <string>
+
+// Prints one named result and hands it back, so a test can do passed &= check(...).
+inline bool check(const std::string& testName, bool result) {
+    std::cout << testName << ": " << std::boolalpha << result << std::endl;
+    return result;
+}
\ No newline at end of file
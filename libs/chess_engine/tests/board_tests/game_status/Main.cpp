@@ -0,0 +1,90 @@
+#include <iostream>
+#include <string>
+#include "../../../src/Board.h"
+#include "../../TestCheck.h"
+
+static Game_Status statusOf(const std::string& fen) {
+    Board board;
+    board.setFromFen(fen);
+    return board.status();
+}
+
+int main(){
+    bool passed = true;
+
+    passed &= check("Start position", statusOf("rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1") == Game_Status::CONTINUE);
+
+    // Test case: Fool's mate, played through moveTo so status is asked for only after the last move.
+    {
+        Board board;
+        const Move moves[]{
+            Move{makeSquare(6, 5), makeSquare(5, 5)}, // f2f3
+            Move{makeSquare(1, 4), makeSquare(3, 4)}, // e7e5
+            Move{makeSquare(6, 6), makeSquare(4, 6)}, // g2g4
+            Move{makeSquare(0, 3), makeSquare(4, 7)}, // d8h4
+        };
+        bool played = true;
+        for(Move move : moves) {
+            played &= board.moveTo(move);
+        }
+        passed &= check("Checkmate", played && board.status() == Game_Status::CHECKMATE_END);
+    }
+
+    passed &= check("Check", statusOf("4k3/8/8/8/8/8/8/4K2r w - - 0 1") == Game_Status::IN_CHECK);
+    passed &= check("Stalemate", statusOf("7k/5Q2/6K1/8/8/8/8/8 b - - 0 1") == Game_Status::DRAW_END);
+
+    // Test case: Knights out and back twice, the start position comes up a third time.
+    {
+        Board board;
+        const Move shuffle[]{
+            Move{makeSquare(7, 6), makeSquare(5, 5)}, // g1f3
+            Move{makeSquare(0, 6), makeSquare(2, 5)}, // g8f6
+            Move{makeSquare(5, 5), makeSquare(7, 6)}, // f3g1
+            Move{makeSquare(2, 5), makeSquare(0, 6)}, // f6g8
+        };
+        for(Move move : shuffle) { board.moveTo(move); }
+        bool twofold = board.isDraw(2) && !board.isDraw(3) && board.status() == Game_Status::CONTINUE;
+        for(Move move : shuffle) { board.moveTo(move); }
+        passed &= check("Repetition", twofold && board.status() == Game_Status::DRAW_END);
+    }
+
+    passed &= check("Fifty-move rule", statusOf("4k3/8/8/8/8/8/8/R3K3 w - - 100 80") == Game_Status::DRAW_END);
+    passed &= check("Mate beats the fifty-move rule", statusOf("R3k3/8/4K3/8/8/8/8/8 b - - 100 80") == Game_Status::CHECKMATE_END);
+
+    // Test case: Insufficient material.
+    {
+        const char* dead[]{
+            "4k3/8/8/8/8/8/8/4K3 w - - 0 1",      // K v K
+            "4k3/8/8/8/8/8/8/4KN2 w - - 0 1",     // KN v K
+            "4k3/8/8/8/8/8/8/4KB2 w - - 0 1",     // KB v K
+            "4kb2/8/8/8/8/8/8/2B1K3 w - - 0 1",   // Bishops on one color
+        };
+        const char* alive[]{
+            "4k3/8/8/8/8/8/8/2B1KB2 w - - 0 1",   // Bishop pair
+            "4kn2/8/8/8/8/8/8/4KB2 w - - 0 1",    // KB v KN
+            "4k3/8/8/8/8/8/8/3NKN2 w - - 0 1",    // Two knights
+            "4k3/8/8/8/8/8/4P3/4K3 w - - 0 1",    // A pawn
+        };
+        bool correct = true;
+        Board board;
+        for(const char* fen : dead) {
+            board.setFromFen(fen);
+            correct &= board.isInsufficientMaterial() && board.status() == Game_Status::DRAW_END;
+        }
+        for(const char* fen : alive) {
+            board.setFromFen(fen);
+            correct &= !board.isInsufficientMaterial();
+        }
+        passed &= check("Insufficient material", correct);
+    }
+
+    // Test case: An illegal move is refused and leaves the position alone.
+    {
+        Board board;
+        const std::string before = board.getFenStr();
+        bool refused = !board.moveTo(Move{makeSquare(6, 4), makeSquare(3, 4)}); // e2e5
+        passed &= check("Illegal move refused", refused && board.getFenStr() == before);
+    }
+
+    return passed ? 0 : 1;
+}
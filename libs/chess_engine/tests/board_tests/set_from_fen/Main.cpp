@@ -0,0 +1,76 @@
+#include <iostream>
+#include <string>
+#include "../../../src/Board.h"
+#include "../../TestCheck.h"
+
+int main(){
+    bool passed = true;
+    Board board;
+
+    // Test case: A full FEN comes back out of writeFen unchanged, multi digit clocks included.
+    {
+        const std::string fen{"r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R b Kq - 37 120"};
+        passed &= check("Round trip", board.setFromFen(fen) && board.getFenStr() == fen);
+    }
+
+    // Test case: An en passant target behind a pawn that just double pushed is kept.
+    {
+        const std::string fen{"rnbqkbnr/ppp1pppp/8/8/3pP3/8/PPPP1PPP/RNBQKBNR b KQkq e3 0 3"};
+        passed &= check("En passant target", board.setFromFen(fen) && board.getFenStr() == fen);
+    }
+
+    // Test case: An EPD line, no clocks and operations after the fields.
+    {
+        bool loaded = board.setFromFen("4k3/8/8/8/8/8/8/4K2R w K - bm Rh8+; id \"test\";");
+        passed &= check("EPD line", loaded && board.getFenStr() == "4k3/8/8/8/8/8/8/4K2R w K - 0 1");
+    }
+
+    // Test case: Malformed input is rejected and the board keeps its previous position.
+    {
+        const std::string before = board.getFenStr();
+        const char* badFens[]{
+            "",
+            "8/8/8/8/8/8/8 w - - 0 1",                 // Seven ranks.
+            "9/8/8/8/8/8/8/8 w - - 0 1",               // Rank too long.
+            "4k3/8/8/8/8/8/8/4K2X w - - 0 1",          // Unknown piece letter.
+            "4k3/8/8/8/8/8/8/4K3 x - - 0 1",           // Bad side to move.
+            "4k3/8/8/8/8/8/8/4K3 w KX - 0 1",          // Bad castling rights.
+            "4k3/8/8/8/8/8/8/4K3 w - e6 0 1",          // No pawn behind the en passant target.
+            "4k3/8/4n3/3Pp3/8/8/8/4K3 w - e6 0 1",     // En passant target occupied.
+            "4k3/4n3/8/3Pp3/8/8/8/4K3 w - e6 0 1",     // Square the pawn pushed from occupied.
+            "4k3/8/8/8/8/8/8/4K3 w - - 0 0",           // Fullmove number starts at 1.
+            "P3k3/8/8/8/8/8/8/4K3 w - - 0 1",          // Pawn on the last rank.
+            "4k3/8/8/8/8/8/8/p3K3 w - - 0 1",          // Pawn on the first rank.
+            "8/8/8/8/8/8/8/4K3 w - - 0 1",             // No black king.
+            "4k3/8/8/8/8/8/8/3KK3 w - - 0 1",          // Two white kings.
+        };
+        bool allRejected = true;
+        for(const char* fen : badFens) {
+            if(board.setFromFen(fen)) {
+                std::cerr << "Accepted bad FEN: " << fen << std::endl;
+                allRejected = false;
+            }
+        }
+        passed &= check("Rejects malformed FEN", allRejected && board.getFenStr() == before);
+    }
+
+    // Test case: The facade follows an in place reset.
+    {
+        board.setFromFen("4k3/8/8/8/8/8/8/4K2R w K - 0 1");
+        const Piece* rook = board.getPieceAt(MAX_ROWS - 1, MAX_COLS - 1);
+        passed &= check("Facade rebuilt", rook && rook->getType() == Piece_T::ROOK && board.getPieceAt(0, 0) == nullptr);
+    }
+
+    // Test case: A snapshot restores the same position into another board, and both play on independently.
+    {
+        board.setFromFen("r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1");
+        const std::string before = board.getFenStr();
+        Board copy{board.snapshot()};
+        copy.moveTo(Move{makeSquare(7, 4), makeSquare(7, 6), Move::Flag_T::CASTLING});
+        bool restored = copy.key() != board.key() && board.getFenStr() == before;
+        copy.setFromSnapshot(board.snapshot());
+        passed &= check("Snapshot", restored && copy.getFenStr() == before && copy.key() == board.key());
+    }
+
+    return passed ? 0 : 1;
+}
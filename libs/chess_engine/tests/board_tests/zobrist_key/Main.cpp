@@ -0,0 +1,82 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include "../../../src/Board.h"
+#include "../../TestCheck.h"
+#include "chess_engine/FENString.h"
+
+// Plays UCI moves on the board, matched against the legal moves so castling and en passant get their flags.
+static bool playMoves(Board& board, const std::vector<std::string>& uciMoves) {
+    for(const std::string& uci : uciMoves) {
+        Move parsed = Move::fromUci(uci);
+        MoveList legalMoves;
+        board.generateLegalMoves(legalMoves);
+        bool found = false;
+        for(Move move : legalMoves) {
+            if(move.from() == parsed.from() && move.to() == parsed.to() && move.promotion() == parsed.promotion()) {
+                board.makeMove(move);
+                found = true;
+                break;
+            }
+        }
+        if(!found) {
+            std::cerr << "Illegal move in test: " << uci << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+int main(){
+    const FENString startPos{std::string{FENString::INIT_FEN}};
+    bool passed = true;
+
+    // Test case: Two move orders reaching the same position share a key.
+    {
+        Board first{startPos};
+        Board second{startPos};
+        if(!playMoves(first, {"g1f3", "g8f6", "b1c3", "b8c6"}) || !playMoves(second, {"b1c3", "b8c6", "g1f3", "g8f6"})) {
+            return 1;
+        }
+        passed &= check("Transposition", first.key() == second.key());
+    }
+
+    // Test case: Side to move is part of the key.
+    {
+        Board white{FENString{"4k3/8/8/8/8/8/8/4K3 w - - 0 1"}};
+        Board black{FENString{"4k3/8/8/8/8/8/8/4K3 b - - 0 1"}};
+        passed &= check("Side to move", white.key() != black.key());
+    }
+
+    // Test case: Castling, en passant and promotion all unmake back to the starting key.
+    {
+        Board board{FENString{"r3k2r/1P6/8/3pP3/8/8/8/R3K2R w KQkq d6 0 1"}};
+        Zobrist::Key startKey = board.key();
+        if(!playMoves(board, {"e5d6", "e8g8", "e1c1", "a8a2", "b7b8q"})) {
+            return 1;
+        }
+        for(int i = 0; i < 5; ++i) {
+            board.unmakeMove();
+        }
+        passed &= check("Make/unmake restores key", board.key() == startKey);
+    }
+
+    // Test case: An en passant target nobody can capture on does not change the key.
+    {
+        Board board{startPos};
+        if(!playMoves(board, {"e2e4"})) {
+            return 1;
+        }
+        Board fromFen{FENString{"rnbqkbnr/pppppppp/8/8/4P3/8/PPPP1PPP/RNBQKBNR b KQkq - 0 1"}};
+        passed &= check("Unusable en passant target", board.key() == fromFen.key());
+    }
+
+    // Test case: A capturable en passant target does.
+    {
+        Board withTarget{FENString{"4k3/8/8/3pP3/8/8/8/4K3 w - d6 0 1"}};
+        Board withoutTarget{FENString{"4k3/8/8/3pP3/8/8/8/4K3 w - - 0 1"}};
+        passed &= check("Usable en passant target", withTarget.key() != withoutTarget.key());
+    }
+
+    return passed ? 0 : 1;
+}
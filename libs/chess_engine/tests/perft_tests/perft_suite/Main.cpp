@@ -0,0 +1,244 @@
+#include <algorithm>
+#include <chrono>
+#include <cinttypes>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include "../../../src/Board.h"
+#include "../../../src/WorkStealingPool.h"
+#include "chess_engine/ChessEngine.h"
+
+/*
+    Perft suite over an EPD file in the usual perftsuite format, one position per line:
+
+        <fen> ;D1 20 ;D2 400 ;D3 8902
+
+        PerftSuite <file.epd> [--depth N] [--deep] [--threads N]
+                   [--engine [--hash MB] [--split PLY] [--no-bulk] [--stats]]
+
+    Every expected count up to --depth (default 3) is checked, --deep checks all of them.
+    --threads 0, the default, uses one thread per hardware thread.
+    By default positions run in parallel, one task each, on a plain make/unmake walk, so only move
+    generation is under test. --engine instead runs the positions one after another through
+    ChessEngine::perft, which splits each one over the threads itself. That covers the engine's own
+    perft: the split, the shared hash, bulk counting off and the statistics walk.
+    Exits non-zero if any count differs from the file or a line does not parse.
+*/
+
+static constexpr unsigned int DEFAULT_DEPTH{3};
+static constexpr const char* USAGE{"usage: PerftSuite <file.epd> [--depth N] [--deep] [--threads N] "
+                                   "[--engine [--hash MB] [--split PLY] [--no-bulk] [--stats]]"};
+
+// Settings handed to ChessEngine in --engine mode.
+struct EngineSettings {
+    bool enabled{false};
+    unsigned long int hashMegabytes{0};
+    unsigned long int splitPly{2};
+    bool bulkCount{true};
+    bool statistics{false};
+};
+
+struct SuiteEntry {
+    std::string fen;
+    std::vector<std::uint64_t> expected; // expected[d - 1] is the count at depth d.
+};
+
+struct SuiteResult {
+    bool loaded{false};
+    unsigned int failedDepth{0}; // 0 when every checked depth matched.
+    std::uint64_t got{0};
+    std::uint64_t nodes{0};  // Summed over every checked depth.
+    double seconds{0.0};
+};
+
+static std::uint64_t perft(Board& board, unsigned int depth) {
+    MoveList moves;
+    board.generateLegalMoves(moves);
+    if(depth == 1) {
+        return moves.size();
+    }
+
+    std::uint64_t nodes{0};
+    for(Move move : moves) {
+        board.makeMove(move);
+        nodes += perft(board, depth - 1);
+        board.unmakeMove();
+    }
+    return nodes;
+}
+
+// Counts one depth through the engine, its per move output is dropped.
+static std::uint64_t enginePerft(ChessEngine& engine, unsigned int depth) {
+    std::streambuf* console = std::cout.rdbuf(nullptr);
+    std::uint64_t nodes = engine.perft(depth);
+    std::cout.rdbuf(console);
+    return nodes;
+}
+
+// Whole decimal numbers only, so a typo is reported rather than thrown out of std::stoul.
+static bool parseNumber(const char* text, unsigned long int& value) {
+    char* end = nullptr;
+    if(*text < '0' || *text > '9') { return false; }
+    value = std::strtoul(text, &end, 10);
+    return *end == '\0';
+}
+
+static void runPosition(const SuiteEntry& entry, SuiteResult& result, unsigned int maxDepth,
+                        unsigned int threads, const EngineSettings& settings) {
+    auto positionStart = std::chrono::steady_clock::now();
+    Board board;
+    result.loaded = board.setFromFen(entry.fen);
+
+    std::unique_ptr<ChessEngine> engine;
+    if(result.loaded && settings.enabled) {
+        engine = std::make_unique<ChessEngine>(FENString{entry.fen});
+        engine->setThreads(threads);
+        engine->setPerftHashSize(settings.hashMegabytes);
+        engine->setPerftSplitPly(static_cast<unsigned int>(settings.splitPly));
+        engine->setPerftBulkCounting(settings.bulkCount);
+        engine->setPerftStatistics(settings.statistics);
+    }
+
+    for(unsigned int depth = 1; result.loaded && depth <= entry.expected.size() && depth <= maxDepth; ++depth) {
+        std::uint64_t nodes = engine ? enginePerft(*engine, depth) : perft(board, depth);
+        result.nodes += nodes;
+        if(nodes != entry.expected[depth - 1]) {
+            result.failedDepth = depth;
+            result.got = nodes;
+            break;
+        }
+    }
+    result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - positionStart).count();
+}
+
+// The FEN is everything before the first ';', each ";Dn count" operation after it is one expectation.
+static bool parseLine(const std::string& line, SuiteEntry& entry) {
+    size_t semicolon = line.find(';');
+    if(semicolon == std::string::npos) { return false; }
+    entry.fen = line.substr(0, line.find_last_not_of(' ', semicolon - 1) + 1);
+
+    while(semicolon != std::string::npos) {
+        size_t next = line.find(';', semicolon + 1);
+        std::string operation = line.substr(semicolon + 1, next == std::string::npos ? std::string::npos : next - semicolon - 1);
+        unsigned int depth{0};
+        std::uint64_t count{0};
+        if(std::sscanf(operation.c_str(), " D%u %" SCNu64, &depth, &count) != 2 || depth != entry.expected.size() + 1) {
+            return false;
+        }
+        entry.expected.push_back(count);
+        semicolon = next;
+    }
+    return !entry.expected.empty();
+}
+
+int main(int argc, char* argv[]) {
+    if(argc < 2) {
+        std::cerr << USAGE << std::endl;
+        return 1;
+    }
+
+    unsigned int maxDepth{DEFAULT_DEPTH};
+    unsigned long int threads{0};
+    EngineSettings settings;
+    for(int i = 2; i < argc; ++i) {
+        std::string arg{argv[i]};
+        unsigned long int number{0};
+        bool takesNumber = arg == "--depth" || arg == "--threads" || arg == "--hash" || arg == "--split";
+        if(takesNumber && (i + 1 == argc || !parseNumber(argv[i + 1], number))) {
+            std::cerr << arg << " needs a whole number" << std::endl << USAGE << std::endl;
+            return 1;
+        }
+
+        if(arg == "--deep") {
+            maxDepth = ~0u;
+        } else if(arg == "--engine") {
+            settings.enabled = true;
+        } else if(arg == "--no-bulk") {
+            settings.bulkCount = false;
+        } else if(arg == "--stats") {
+            settings.statistics = true;
+        } else if(arg == "--depth") {
+            maxDepth = static_cast<unsigned int>(number);
+        } else if(arg == "--threads") {
+            threads = number;
+        } else if(arg == "--hash") {
+            settings.hashMegabytes = number;
+        } else if(arg == "--split") {
+            settings.splitPly = number;
+        } else {
+            std::cerr << "unknown argument: " << arg << std::endl << USAGE << std::endl;
+            return 1;
+        }
+        i += takesNumber ? 1 : 0;
+    }
+
+    // Resolved here so the summary reports the threads that actually ran.
+    if(threads == 0) {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    std::ifstream file{argv[1]};
+    if(!file) {
+        std::cerr << "cannot open " << argv[1] << std::endl;
+        return 1;
+    }
+
+    std::vector<SuiteEntry> entries;
+    std::string line;
+    while(std::getline(file, line)) {
+        if(line.empty() || line[0] == '#') { continue; }
+        SuiteEntry entry;
+        if(!parseLine(line, entry)) {
+            std::cerr << "malformed line: " << line << std::endl;
+            return 1;
+        }
+        entries.push_back(std::move(entry));
+    }
+
+    std::vector<SuiteResult> results(entries.size());
+    auto start = std::chrono::steady_clock::now();
+    if(settings.enabled) {
+        for(size_t i = 0; i < entries.size(); ++i) {
+            runPosition(entries[i], results[i], maxDepth, static_cast<unsigned int>(threads), settings);
+        }
+    } else {
+        WorkStealingPool pool{static_cast<unsigned int>(threads)};
+        for(size_t i = 0; i < entries.size(); ++i) {
+            pool.submit([&entry = entries[i], &result = results[i], maxDepth, threads, &settings] {
+                runPosition(entry, result, maxDepth, static_cast<unsigned int>(threads), settings);
+            });
+        }
+        pool.wait();
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    bool passed = true;
+    std::uint64_t totalNodes{0};
+    for(size_t i = 0; i < entries.size(); ++i) {
+        const SuiteResult& result = results[i];
+        totalNodes += result.nodes;
+        if(!result.loaded) {
+            std::cout << "FAIL invalid FEN  " << entries[i].fen << std::endl;
+            passed = false;
+        } else if(result.failedDepth != 0) {
+            std::cout << "FAIL depth " << result.failedDepth << " got " << result.got
+                      << " expected " << entries[i].expected[result.failedDepth - 1] << "  " << entries[i].fen << std::endl;
+            passed = false;
+        } else {
+            double nps = result.seconds > 0.0 ? static_cast<double>(result.nodes) / result.seconds : 0.0;
+            std::cout << "ok   " << result.nodes << " nodes  " << static_cast<std::uint64_t>(nps) << " nps  "
+                      << entries[i].fen << std::endl;
+        }
+    }
+
+    double nps = seconds > 0.0 ? static_cast<double>(totalNodes) / seconds : 0.0;
+    std::cout << std::endl << entries.size() << " positions, " << totalNodes << " nodes in " << seconds << " s, "
+              << static_cast<std::uint64_t>(nps) << " nps on " << threads << " threads" << std::endl;
+    return passed ? 0 : 1;
+}
\ No newline at end of file
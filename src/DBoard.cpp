@@ -2,7 +2,7 @@
 #include <stdexcept>
 #include <sstream>
 
-DBoard::DBoard() : DBoard(FEN_STARTING_POS){}
+DBoard::DBoard() : DBoard(FENString{std::string{FEN_STARTING_POS}}){}
 
 //"rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR"
 DBoard::DBoard(const FENString& fen) {
@@ -18,7 +18,17 @@ static void clearScreen() {
 #endif
 }
 
-Game::Game() : m_currentFEN{FEN_STARTING_POS}, m_turn{Color_T::WHITE}, m_dboard{}, m_gameActive{false} {};
+static const char* moveCheckMessage(MoveCheck_T check) {
+    switch(check) {
+        case MoveCheck_T::NO_PIECE: return "Error: No piece at source square.";
+        case MoveCheck_T::WRONG_TURN: return "Error: It's not that player's turn!";
+        case MoveCheck_T::MUST_ESCAPE_CHECK: return "Invalid Move! Must get out of check!";
+        case MoveCheck_T::LEAVES_KING_IN_CHECK: return "Invalid Move! Cannot put your own king in check!";
+        default: return "Invalid Move!";
+    }
+}
+
+Game::Game() : m_currentFEN{std::string{FEN_STARTING_POS}}, m_turn{Color_T::WHITE}, m_dboard{}, m_gameActive{false} {};
 
 Game::Game(const FENString& fen) : m_currentFEN{fen}, m_turn{Color_T::WHITE}, m_dboard{fen}, m_gameActive{false} {};
 
@@ -32,7 +42,7 @@ void Game::_flipTurn() {
 
 void Game::_reset() {
     // Reset to starting position
-    m_currentFEN = FENString{FEN_STARTING_POS};
+    m_currentFEN = FENString{std::string{FEN_STARTING_POS}};
     m_dboard = DBoard();
     m_turn = Color_T::WHITE;
 }
@@ -80,6 +90,12 @@ void Game::start(){
 
             // Create engine with current FEN state for move validation
             ChessEngine engine{m_currentFEN};
+            MoveCheck_T check = engine.checkMove(move);
+            if(check != MoveCheck_T::LEGAL){
+                error << moveCheckMessage(check) << std::endl;
+                continue;
+            }
+
             Game_Status STATUS = engine.isValidMove(move);
             if(STATUS != Game_Status::INVALID){
                 updateFENAfterMove(engine.getFenStr());
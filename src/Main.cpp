@@ -9,7 +9,7 @@ int main(int argc, char* argv[]){
         // Show interactive menu
     } else {
         // Default: Start in UCI mode for GUI compatibility
-        ChessEngine engine{FEN_STARTING_POS};
+        ChessEngine engine;
         engine.uciStart();
         return 0;
     }
@@ -35,14 +35,14 @@ int main(int argc, char* argv[]){
     if(option == 4){
         exit(0);
     } else if (option == 3){
-        ChessEngine engine{FEN_STARTING_POS};
+        ChessEngine engine;
         engine.uciStart();
     } else if(option == 2){
         std::string fenInput;
         std::cout << "Enter a fen or type 's' for starting fen: ";
         std::getline(std::cin, fenInput);
         if(fenInput == "s"){
-            fenInput = FEN_STARTING_POS.getFen();
+            fenInput = std::string{FEN_STARTING_POS};
         }
         try{
             FENString fen{fenInput};
@@ -57,7 +57,7 @@ int main(int argc, char* argv[]){
         std::cout << "Enter a fen or type 's' for starting fen: ";
         std::getline(std::cin, fenInput);
         if(fenInput == "s"){
-            fenInput = FEN_STARTING_POS.getFen();
+            fenInput = std::string{FEN_STARTING_POS};
         }
         try{
             FENString fen{fenInput};